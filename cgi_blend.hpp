@@ -0,0 +1,558 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_BLEND_HPP
+#define CGI_BLEND_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+#include "cgi_color.hpp"
+#include <cstring>
+
+// define CGI_NO_SIMD before including any cgi header to build the scalar kernels only
+#if !defined(CGI_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define CGI_BLEND_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(CGI_BLEND_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CGI_TARGET_SSE2 __attribute__((target("sse2")))
+#define CGI_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CGI_TARGET_SSE2
+#define CGI_TARGET_AVX2
+#endif
+
+namespace cgi
+{
+    /// @brief fixed point span blending. every kernel computes dst = (src*a + dst*(255-a)) / 255 rounded to nearest, per 8 bit channel, so the scalar, sse2 and avx2 paths give bit identical results
+    namespace blend
+    {
+        static_assert(sizeof(cgi::type::color_t) == 4, "span kernels expect 32 bit pixels");
+
+        /// @brief instruction set used by the span kernels
+        enum class PATH
+        {
+            SCALAR,
+            SSE2,
+            AVX2
+        };
+
+        /// @brief converts a 0..1 float opacity to the 0..255 fixed point alpha used by the kernels
+        /// @param alpha opacity from 0 to 1, values outside are clamped
+        /// @return alpha in 0..255
+        inline int to_alpha8(float alpha) noexcept
+        {
+            if (!(alpha > 0))
+                return 0;
+            if (alpha >= 1)
+                return 255;
+            return (int)(alpha * 255.0f + 0.5f);
+        }
+
+        /// @brief packs an rgba_t into one 32 bit value with the fixed point opacity in the top byte (0xAABBGGRR)
+        /// @param color color to pack
+        /// @return packed color
+        inline cgi::type::color_t pack(const cgi::type::rgba_t &color) noexcept
+        {
+            return cgi::type::rgba8_t(color).value;
+        }
+
+        /// @brief blends one pixel, all four bytes treated alike
+        /// @param dst destination pixel
+        /// @param src source pixel
+        /// @param alpha source opacity 0..255
+        /// @return blended pixel
+        inline cgi::type::color_t blend_pixel(cgi::type::color_t dst, cgi::type::color_t src, int alpha) noexcept
+        {
+            const std::uint32_t inv = 255 - alpha;
+            std::uint32_t out = 0;
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                std::uint32_t t = ((src >> shift) & 0xff) * alpha + ((dst >> shift) & 0xff) * inv + 128;
+                out |= (((t + (t >> 8)) >> 8) & 0xff) << shift;
+            }
+            return out;
+        }
+
+        namespace scalar
+        {
+            inline void fill(cgi::type::color_t *dst, int count, cgi::type::color_t src, int alpha) noexcept
+            {
+                for (int i = 0; i < count; i++)
+                    dst[i] = cgi::blend::blend_pixel(dst[i], src, alpha);
+            }
+
+            inline void copy(cgi::type::color_t *dst, const cgi::type::color_t *src, int count, int alpha) noexcept
+            {
+                for (int i = 0; i < count; i++)
+                    dst[i] = cgi::blend::blend_pixel(dst[i], src[i], alpha);
+            }
+
+            inline void packed(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    const int alpha = (int)(src[i] >> 24);
+                    dst[i] = (cgi::blend::blend_pixel(dst[i], src[i], alpha) & 0x00ffffff) | (dst[i] & 0xff000000);
+                }
+            }
+
+            inline void premultiplied(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    const std::uint32_t inv = 255 - (src[i] >> 24);
+                    cgi::type::color_t out = dst[i] & 0xff000000;
+                    for (int shift = 0; shift < 24; shift += 8)
+                    {
+                        std::uint32_t t = ((dst[i] >> shift) & 0xff) * inv + 128;
+                        std::uint32_t c = ((src[i] >> shift) & 0xff) + ((t + (t >> 8)) >> 8);
+                        out |= (cgi::type::color_t)std::min(c, 255u) << shift;
+                    }
+                    dst[i] = out;
+                }
+            }
+        }
+
+        /// @brief table driven kernels used in BLEND_MODE::LINEAR
+        namespace linear
+        {
+            inline void fill(cgi::type::color_t *dst, int count, cgi::type::color_t src, int alpha) noexcept
+            {
+                for (int i = 0; i < count; i++)
+                    dst[i] = cgi::color::blend_linear(dst[i], src, alpha);
+            }
+
+            inline void copy(cgi::type::color_t *dst, const cgi::type::color_t *src, int count, int alpha) noexcept
+            {
+                for (int i = 0; i < count; i++)
+                    dst[i] = cgi::color::blend_linear(dst[i], src[i], alpha);
+            }
+
+            inline void packed(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    const int alpha = (int)(src[i] >> 24);
+                    if (alpha == 255)
+                        dst[i] = (src[i] & 0x00ffffff) | (dst[i] & 0xff000000);
+                    else if (alpha)
+                        dst[i] = (cgi::color::blend_linear(dst[i], src[i], alpha) & 0x00ffffff) | (dst[i] & 0xff000000);
+                }
+            }
+        }
+
+#ifdef CGI_BLEND_X86
+        namespace sse2
+        {
+            /// @brief blends 8 widened channels (two pixels) with per lane alpha
+            CGI_TARGET_SSE2 inline __m128i mix(__m128i s, __m128i d, __m128i a) noexcept
+            {
+                const __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), a);
+                __m128i t = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, inv)), _mm_set1_epi16(128));
+                return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+            }
+
+            CGI_TARGET_SSE2 inline void fill(cgi::type::color_t *dst, int count, cgi::type::color_t src, int alpha) noexcept
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i s = _mm_unpacklo_epi8(_mm_set1_epi32((int)src), zero);
+                const __m128i a = _mm_set1_epi16((short)alpha);
+                int i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+                    __m128i lo = mix(s, _mm_unpacklo_epi8(d, zero), a);
+                    __m128i hi = mix(s, _mm_unpackhi_epi8(d, zero), a);
+                    _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+                }
+                cgi::blend::scalar::fill(dst + i, count - i, src, alpha);
+            }
+
+            CGI_TARGET_SSE2 inline void copy(cgi::type::color_t *dst, const cgi::type::color_t *src, int count, int alpha) noexcept
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i a = _mm_set1_epi16((short)alpha);
+                int i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+                    __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+                    __m128i lo = mix(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), a);
+                    __m128i hi = mix(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), a);
+                    _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+                }
+                cgi::blend::scalar::copy(dst + i, src + i, count - i, alpha);
+            }
+
+            CGI_TARGET_SSE2 inline void packed(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i keep = _mm_set1_epi32((int)0xff000000);
+                int i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+                    __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+
+                    __m128i s_lo = _mm_unpacklo_epi8(s, zero);
+                    __m128i s_hi = _mm_unpackhi_epi8(s, zero);
+                    __m128i a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                    __m128i a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+                    __m128i lo = mix(s_lo, _mm_unpacklo_epi8(d, zero), a_lo);
+                    __m128i hi = mix(s_hi, _mm_unpackhi_epi8(d, zero), a_hi);
+                    __m128i out = _mm_packus_epi16(lo, hi);
+                    out = _mm_or_si128(_mm_andnot_si128(keep, out), _mm_and_si128(keep, d));
+                    _mm_storeu_si128((__m128i *)(dst + i), out);
+                }
+                cgi::blend::scalar::packed(dst + i, src + i, count - i);
+            }
+
+            CGI_TARGET_SSE2 inline void premultiplied(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i full = _mm_set1_epi16(255);
+                const __m128i half = _mm_set1_epi16(128);
+                const __m128i keep = _mm_set1_epi32((int)0xff000000);
+                int i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+                    __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+
+                    __m128i s_lo = _mm_unpacklo_epi8(s, zero);
+                    __m128i s_hi = _mm_unpackhi_epi8(s, zero);
+                    __m128i inv_lo = _mm_sub_epi16(full, _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+                    __m128i inv_hi = _mm_sub_epi16(full, _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+
+                    __m128i t_lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv_lo), half);
+                    __m128i t_hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv_hi), half);
+                    t_lo = _mm_srli_epi16(_mm_add_epi16(t_lo, _mm_srli_epi16(t_lo, 8)), 8);
+                    t_hi = _mm_srli_epi16(_mm_add_epi16(t_hi, _mm_srli_epi16(t_hi, 8)), 8);
+
+                    __m128i out = _mm_adds_epu8(s, _mm_packus_epi16(t_lo, t_hi));
+                    out = _mm_or_si128(_mm_andnot_si128(keep, out), _mm_and_si128(keep, d));
+                    _mm_storeu_si128((__m128i *)(dst + i), out);
+                }
+                cgi::blend::scalar::premultiplied(dst + i, src + i, count - i);
+            }
+        }
+
+        namespace avx2
+        {
+            CGI_TARGET_AVX2 inline __m256i mix(__m256i s, __m256i d, __m256i a) noexcept
+            {
+                const __m256i inv = _mm256_sub_epi16(_mm256_set1_epi16(255), a);
+                __m256i t = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(s, a), _mm256_mullo_epi16(d, inv)), _mm256_set1_epi16(128));
+                return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+            }
+
+            CGI_TARGET_AVX2 inline void fill(cgi::type::color_t *dst, int count, cgi::type::color_t src, int alpha) noexcept
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i s = _mm256_unpacklo_epi8(_mm256_set1_epi32((int)src), zero);
+                const __m256i a = _mm256_set1_epi16((short)alpha);
+                int i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+                    __m256i lo = mix(s, _mm256_unpacklo_epi8(d, zero), a);
+                    __m256i hi = mix(s, _mm256_unpackhi_epi8(d, zero), a);
+                    _mm256_storeu_si256((__m256i *)(dst + i), _mm256_packus_epi16(lo, hi));
+                }
+                cgi::blend::sse2::fill(dst + i, count - i, src, alpha);
+            }
+
+            CGI_TARGET_AVX2 inline void copy(cgi::type::color_t *dst, const cgi::type::color_t *src, int count, int alpha) noexcept
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i a = _mm256_set1_epi16((short)alpha);
+                int i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+                    __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+                    __m256i lo = mix(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), a);
+                    __m256i hi = mix(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), a);
+                    _mm256_storeu_si256((__m256i *)(dst + i), _mm256_packus_epi16(lo, hi));
+                }
+                cgi::blend::sse2::copy(dst + i, src + i, count - i, alpha);
+            }
+
+            CGI_TARGET_AVX2 inline void packed(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i keep = _mm256_set1_epi32((int)0xff000000);
+                int i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+                    __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+
+                    __m256i s_lo = _mm256_unpacklo_epi8(s, zero);
+                    __m256i s_hi = _mm256_unpackhi_epi8(s, zero);
+                    __m256i a_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                    __m256i a_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+                    __m256i lo = mix(s_lo, _mm256_unpacklo_epi8(d, zero), a_lo);
+                    __m256i hi = mix(s_hi, _mm256_unpackhi_epi8(d, zero), a_hi);
+                    __m256i out = _mm256_packus_epi16(lo, hi);
+                    out = _mm256_or_si256(_mm256_andnot_si256(keep, out), _mm256_and_si256(keep, d));
+                    _mm256_storeu_si256((__m256i *)(dst + i), out);
+                }
+                cgi::blend::sse2::packed(dst + i, src + i, count - i);
+            }
+
+            CGI_TARGET_AVX2 inline void premultiplied(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i full = _mm256_set1_epi16(255);
+                const __m256i half = _mm256_set1_epi16(128);
+                const __m256i keep = _mm256_set1_epi32((int)0xff000000);
+                int i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+                    __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+
+                    __m256i s_lo = _mm256_unpacklo_epi8(s, zero);
+                    __m256i s_hi = _mm256_unpackhi_epi8(s, zero);
+                    __m256i inv_lo = _mm256_sub_epi16(full, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+                    __m256i inv_hi = _mm256_sub_epi16(full, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+
+                    __m256i t_lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), inv_lo), half);
+                    __m256i t_hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), inv_hi), half);
+                    t_lo = _mm256_srli_epi16(_mm256_add_epi16(t_lo, _mm256_srli_epi16(t_lo, 8)), 8);
+                    t_hi = _mm256_srli_epi16(_mm256_add_epi16(t_hi, _mm256_srli_epi16(t_hi, 8)), 8);
+
+                    __m256i out = _mm256_adds_epu8(s, _mm256_packus_epi16(t_lo, t_hi));
+                    out = _mm256_or_si256(_mm256_andnot_si256(keep, out), _mm256_and_si256(keep, d));
+                    _mm256_storeu_si256((__m256i *)(dst + i), out);
+                }
+                cgi::blend::sse2::premultiplied(dst + i, src + i, count - i);
+            }
+        }
+
+        /// @brief checks what the running cpu and os support
+        /// @return best path available on this machine
+        inline PATH detect_path() noexcept
+        {
+#if defined(_MSC_VER)
+            int info[4] = {};
+            __cpuid(info, 1);
+            const bool sse2 = (info[3] & (1 << 26)) != 0;
+            const bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6);
+            bool avx2 = false;
+            if (os_avx)
+            {
+                __cpuidex(info, 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+            }
+            if (avx2)
+                return PATH::AVX2;
+            if (sse2)
+                return PATH::SSE2;
+            return PATH::SCALAR;
+#else
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return PATH::AVX2;
+            if (__builtin_cpu_supports("sse2"))
+                return PATH::SSE2;
+            return PATH::SCALAR;
+#endif
+        }
+#else
+        inline PATH detect_path() noexcept
+        {
+            return PATH::SCALAR;
+        }
+#endif
+
+        /// @brief the path picked at runtime. detected once on first use
+        inline PATH &active_path() noexcept
+        {
+            static PATH path = cgi::blend::detect_path();
+            return path;
+        }
+
+        /// @brief forces a path, e.g. PATH::SCALAR for benchmarking or reference output. a path the cpu does not support falls back to the detected one
+        /// @param path path to use from now on
+        inline void set_path(PATH path) noexcept
+        {
+            const PATH best = cgi::blend::detect_path();
+            cgi::blend::active_path() = ((int)path > (int)best) ? best : path;
+        }
+
+        /// @brief the blend mode used by every span kernel, BLEND_MODE::SRGB unless changed
+        inline cgi::type::blend_mode_t &active_mode() noexcept
+        {
+            static cgi::type::blend_mode_t mode = cgi::type::blend_mode_t::SRGB;
+            return mode;
+        }
+
+        /// @brief switches between fast sRGB blending and table driven linear light blending. opaque stores are unaffected and premultiplied spans always blend in sRGB. set it between frames, not while a surface is drawing
+        /// @param mode mode to use from now on
+        inline void set_mode(cgi::type::blend_mode_t mode) noexcept
+        {
+            cgi::blend::active_mode() = mode;
+        }
+
+        /// @brief blends one pixel in the active blend mode, for paths that touch single pixels
+        /// @param dst destination pixel
+        /// @param src source pixel
+        /// @param alpha source opacity 0..255
+        /// @return blended pixel
+        inline cgi::type::color_t blend_one(cgi::type::color_t dst, cgi::type::color_t src, int alpha) noexcept
+        {
+            if (cgi::blend::active_mode() == cgi::type::blend_mode_t::LINEAR)
+                return cgi::color::blend_linear(dst, src, alpha);
+            return cgi::blend::blend_pixel(dst, src, alpha);
+        }
+
+        /// @brief blends one constant color over a span
+        /// @param dst first destination pixel
+        /// @param count number of pixels
+        /// @param src source color
+        /// @param alpha source opacity 0..255
+        inline void span_fill(cgi::type::color_t *dst, int count, cgi::type::color_t src, int alpha) noexcept
+        {
+            if (count <= 0 || alpha <= 0)
+                return;
+            if (alpha >= 255)
+            {
+                std::fill(dst, dst + count, src);
+                return;
+            }
+
+            if (cgi::blend::active_mode() == cgi::type::blend_mode_t::LINEAR)
+            {
+                cgi::blend::linear::fill(dst, count, src, alpha);
+                return;
+            }
+
+            switch (cgi::blend::active_path())
+            {
+#ifdef CGI_BLEND_X86
+            case PATH::AVX2:
+                cgi::blend::avx2::fill(dst, count, src, alpha);
+                return;
+            case PATH::SSE2:
+                cgi::blend::sse2::fill(dst, count, src, alpha);
+                return;
+#endif
+            default:
+                cgi::blend::scalar::fill(dst, count, src, alpha);
+                return;
+            }
+        }
+
+        /// @brief blends a source span over a destination span with one opacity for every pixel
+        /// @param dst first destination pixel
+        /// @param src first source pixel
+        /// @param count number of pixels
+        /// @param alpha source opacity 0..255
+        inline void span_copy(cgi::type::color_t *dst, const cgi::type::color_t *src, int count, int alpha) noexcept
+        {
+            if (count <= 0 || alpha <= 0)
+                return;
+            if (alpha >= 255)
+            {
+                std::memmove(dst, src, (size_t)count * sizeof(cgi::type::color_t));
+                return;
+            }
+
+            if (cgi::blend::active_mode() == cgi::type::blend_mode_t::LINEAR)
+            {
+                cgi::blend::linear::copy(dst, src, count, alpha);
+                return;
+            }
+
+            switch (cgi::blend::active_path())
+            {
+#ifdef CGI_BLEND_X86
+            case PATH::AVX2:
+                cgi::blend::avx2::copy(dst, src, count, alpha);
+                return;
+            case PATH::SSE2:
+                cgi::blend::sse2::copy(dst, src, count, alpha);
+                return;
+#endif
+            default:
+                cgi::blend::scalar::copy(dst, src, count, alpha);
+                return;
+            }
+        }
+
+        /// @brief blends a source span that carries its own opacity in the top byte of every pixel (0xAABBGGRR). the top byte of the destination is kept
+        /// @param dst first destination pixel
+        /// @param src first source pixel
+        /// @param count number of pixels
+        inline void span_packed(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+        {
+            if (count <= 0)
+                return;
+
+            if (cgi::blend::active_mode() == cgi::type::blend_mode_t::LINEAR)
+            {
+                cgi::blend::linear::packed(dst, src, count);
+                return;
+            }
+
+            switch (cgi::blend::active_path())
+            {
+#ifdef CGI_BLEND_X86
+            case PATH::AVX2:
+                cgi::blend::avx2::packed(dst, src, count);
+                return;
+            case PATH::SSE2:
+                cgi::blend::sse2::packed(dst, src, count);
+                return;
+#endif
+            default:
+                cgi::blend::scalar::packed(dst, src, count);
+                return;
+            }
+        }
+
+        /// @brief blends a premultiplied source span (0xAABBGGRR, color already multiplied by alpha), dst = src + dst*(255-a)/255. the top byte of the destination is kept
+        /// @param dst first destination pixel
+        /// @param src first source pixel
+        /// @param count number of pixels
+        inline void span_premultiplied(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+        {
+            if (count <= 0)
+                return;
+
+            switch (cgi::blend::active_path())
+            {
+#ifdef CGI_BLEND_X86
+            case PATH::AVX2:
+                cgi::blend::avx2::premultiplied(dst, src, count);
+                return;
+            case PATH::SSE2:
+                cgi::blend::sse2::premultiplied(dst, src, count);
+                return;
+#endif
+            default:
+                cgi::blend::scalar::premultiplied(dst, src, count);
+                return;
+            }
+        }
+    }
+}
+
+#endif
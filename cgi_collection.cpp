@@ -45,11 +45,7 @@ const int pipe_width = 70;
 bool game_over = false;
 
 void draw_rect(int x, int y, int w, int h, type::color_t color) {
-    for (int iy = y; iy < y + h; ++iy) {
-        for (int ix = x; ix < x + w; ++ix) {
-            win.set_pixel(ix, iy, color);
-        }
-    }
+    win.fill_rect(x, y, w, h, color);
 }
 
 void reset_game() {
@@ -144,6 +140,8 @@ void handle_input() {
 int main() {
     std::srand(std::time(nullptr));
 
+    // draw straight into the dib, present is only a BitBlt
+    win.set_pixel_format(cgi::type::pixel_format_t::BGRA);
     win.create(true);
     win.show();
     reset_game();
@@ -0,0 +1,139 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_COLOR_HPP
+#define CGI_COLOR_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+
+namespace cgi
+{
+    namespace type
+    {
+        /// @brief fixed size list of colors, can be built at compile time
+        template <std::size_t count>
+        using palette_t = std::array<cgi::type::color_t, count>;
+    }
+
+    namespace color
+    {
+        /// @brief common colors, usable anywhere a constant expression is needed
+        namespace named
+        {
+            constexpr cgi::type::color_t black = cgi::color::rgb(0, 0, 0);
+            constexpr cgi::type::color_t white = cgi::color::rgb(255, 255, 255);
+            constexpr cgi::type::color_t gray = cgi::color::rgb(128, 128, 128);
+            constexpr cgi::type::color_t light_gray = cgi::color::rgb(192, 192, 192);
+            constexpr cgi::type::color_t dark_gray = cgi::color::rgb(64, 64, 64);
+            constexpr cgi::type::color_t red = cgi::color::rgb(255, 0, 0);
+            constexpr cgi::type::color_t green = cgi::color::rgb(0, 255, 0);
+            constexpr cgi::type::color_t blue = cgi::color::rgb(0, 0, 255);
+            constexpr cgi::type::color_t yellow = cgi::color::rgb(255, 255, 0);
+            constexpr cgi::type::color_t cyan = cgi::color::rgb(0, 255, 255);
+            constexpr cgi::type::color_t magenta = cgi::color::rgb(255, 0, 255);
+            constexpr cgi::type::color_t orange = cgi::color::rgb(255, 165, 0);
+            constexpr cgi::type::color_t purple = cgi::color::rgb(128, 0, 128);
+            constexpr cgi::type::color_t brown = cgi::color::rgb(139, 69, 19);
+            constexpr cgi::type::color_t pink = cgi::color::rgb(255, 192, 203);
+        }
+
+        /// @brief mixes two colors per channel, all four bytes, with the same rounding as the blend kernels
+        /// @param from color at t = 0
+        /// @param to color at t = 255
+        /// @param t position from 0 to 255
+        /// @return mixed color
+        constexpr cgi::type::color_t mix(cgi::type::color_t from, cgi::type::color_t to, int t) noexcept
+        {
+            t = t < 0 ? 0 : (t > 255 ? 255 : t);
+
+            cgi::type::color_t out = 0;
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                const std::uint32_t v = ((to >> shift) & 0xff) * (std::uint32_t)t + ((from >> shift) & 0xff) * (std::uint32_t)(255 - t) + 128;
+                out |= (cgi::type::color_t)(((v + (v >> 8)) >> 8) & 0xff) << shift;
+            }
+            return out;
+        }
+
+        /// @brief evenly spaced colors from one color to another, ends included
+        /// @tparam count number of colors
+        /// @param from first color
+        /// @param to last color
+        /// @return the palette
+        template <std::size_t count>
+        constexpr cgi::type::palette_t<count> gradient(cgi::type::color_t from, cgi::type::color_t to) noexcept
+        {
+            cgi::type::palette_t<count> palette{};
+            for (std::size_t i = 0; i < count; i++)
+            {
+                const int t = count > 1 ? (int)((i * 255 + (count - 1) / 2) / (count - 1)) : 0;
+                palette[i] = cgi::color::mix(from, to, t);
+            }
+            return palette;
+        }
+
+        /// @brief sRGB <-> linear light lookup tables. linear values are 16 bit, the way back uses the top 12 bits
+        struct srgb_tables
+        {
+            std::uint16_t to_linear[256];
+            std::uint8_t to_srgb[4096];
+        };
+
+        /// @brief the tables, built once on first use
+        inline const cgi::color::srgb_tables &srgb()
+        {
+            static const cgi::color::srgb_tables tables = []
+            {
+                cgi::color::srgb_tables t{};
+
+                for (int i = 0; i < 256; i++)
+                {
+                    const double c = i / 255.0;
+                    const double l = c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+                    t.to_linear[i] = (std::uint16_t)std::lround(l * 65535.0);
+                }
+
+                for (int i = 0; i < 4096; i++)
+                {
+                    const double l = (i * 16 + 8) / 65535.0;
+                    const double c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+                    t.to_srgb[i] = (std::uint8_t)std::lround(std::min(std::max(c, 0.0), 1.0) * 255.0);
+                }
+
+                return t;
+            }();
+
+            return tables;
+        }
+
+        /// @brief blends one pixel in linear light. the color channels go through the tables, the top byte is mixed directly
+        /// @param dst destination pixel
+        /// @param src source pixel
+        /// @param alpha source opacity 0..255
+        /// @return blended pixel
+        inline cgi::type::color_t blend_linear(cgi::type::color_t dst, cgi::type::color_t src, int alpha) noexcept
+        {
+            const cgi::color::srgb_tables &t = cgi::color::srgb();
+            const std::uint32_t inv = 255 - alpha;
+
+            cgi::type::color_t out = cgi::color::mix(dst, src, alpha) & 0xff000000;
+            for (int shift = 0; shift < 24; shift += 8)
+            {
+                const std::uint32_t v = t.to_linear[(src >> shift) & 0xff] * (std::uint32_t)alpha + t.to_linear[(dst >> shift) & 0xff] * inv + 127;
+                out |= (cgi::type::color_t)t.to_srgb[(v / 255) >> 4] << shift;
+            }
+            return out;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,118 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_CONVERT_HPP
+#define CGI_CONVERT_HPP
+
+#pragma once
+
+#include "cgi_blend.hpp"
+
+namespace cgi
+{
+    /// @brief pixel format conversion between the api color layout (COLORREF, 0x00BBGGRR) and the native 32 bit dib layout (BGRA in memory, 0x00RRGGBB). the conversion swaps red and blue and keeps green and the top byte, so it is its own inverse
+    namespace convert
+    {
+        /// @brief swaps red and blue of one pixel
+        /// @param color pixel in either layout
+        /// @return pixel in the other layout
+        inline constexpr cgi::type::color_t swap_red_blue(cgi::type::color_t color) noexcept
+        {
+            return (color & 0xff00ff00) | ((color >> 16) & 0xff) | ((color & 0xff) << 16);
+        }
+
+        namespace scalar
+        {
+            inline void swap_red_blue(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+            {
+                for (int i = 0; i < count; i++)
+                    dst[i] = cgi::convert::swap_red_blue(src[i]);
+            }
+        }
+
+#ifdef CGI_BLEND_X86
+        namespace sse2
+        {
+            CGI_TARGET_SSE2 inline void swap_red_blue(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+            {
+                const __m128i keep = _mm_set1_epi32((int)0xff00ff00);
+                const __m128i low = _mm_set1_epi32(0xff);
+                int i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+                    __m128i out = _mm_or_si128(_mm_and_si128(s, keep), _mm_and_si128(_mm_srli_epi32(s, 16), low));
+                    out = _mm_or_si128(out, _mm_slli_epi32(_mm_and_si128(s, low), 16));
+                    _mm_storeu_si128((__m128i *)(dst + i), out);
+                }
+                cgi::convert::scalar::swap_red_blue(dst + i, src + i, count - i);
+            }
+        }
+
+        namespace avx2
+        {
+            CGI_TARGET_AVX2 inline void swap_red_blue(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+            {
+                const __m256i order = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                                       2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+                int i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+                    _mm256_storeu_si256((__m256i *)(dst + i), _mm256_shuffle_epi8(s, order));
+                }
+                cgi::convert::sse2::swap_red_blue(dst + i, src + i, count - i);
+            }
+        }
+#endif
+
+        /// @brief converts a span between the api layout and the native dib layout. dst and src may be the same span
+        /// @param dst first destination pixel
+        /// @param src first source pixel
+        /// @param count number of pixels
+        inline void swap_red_blue(cgi::type::color_t *dst, const cgi::type::color_t *src, int count) noexcept
+        {
+            if (count <= 0)
+                return;
+
+            switch (cgi::blend::active_path())
+            {
+#ifdef CGI_BLEND_X86
+            case cgi::blend::PATH::AVX2:
+                cgi::convert::avx2::swap_red_blue(dst, src, count);
+                return;
+            case cgi::blend::PATH::SSE2:
+                cgi::convert::sse2::swap_red_blue(dst, src, count);
+                return;
+#endif
+            default:
+                cgi::convert::scalar::swap_red_blue(dst, src, count);
+                return;
+            }
+        }
+
+        /// @brief converts a rectangle of rows between the two layouts
+        /// @param dst first destination pixel
+        /// @param dst_stride distance between destination rows in pixels
+        /// @param src first source pixel
+        /// @param src_stride distance between source rows in pixels
+        /// @param width pixels per row
+        /// @param height number of rows
+        inline void swap_red_blue(cgi::type::color_t *dst, int dst_stride, const cgi::type::color_t *src, int src_stride, int width, int height) noexcept
+        {
+            for (int i = 0; i < height; i++)
+            {
+                cgi::convert::swap_red_blue(dst + (size_t)i * dst_stride, src + (size_t)i * src_stride, width);
+            }
+        }
+    }
+}
+
+#endif
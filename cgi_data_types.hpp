@@ -19,43 +19,65 @@ namespace cgi
     {
         
         using refresh_t = cgi::values::REFRESH_TYPE;
+        using pixel_format_t = cgi::values::PIXEL_FORMAT;
+        using alpha_mode_t = cgi::values::ALPHA_MODE;
+        using blend_mode_t = cgi::values::BLEND_MODE;
+        using pacing_t = cgi::values::PACING_MODE;
+        using phase_t = cgi::values::FRAME_PHASE;
+        using mouse_button_t = cgi::values::MOUSE_BUTTON;
+        using input_kind_t = cgi::values::INPUT_EVENT;
+        using record_format_t = cgi::values::RECORD_FORMAT;
+        using backpressure_t = cgi::values::BACKPRESSURE;
 
+#ifdef _WIN32
         using color_t = COLORREF;
         using cursor_t = HCURSOR;
+#else
+        /// @brief same layout as the win32 COLORREF (0x00BBGGRR) so headless builds share every color path
+        using color_t = std::uint32_t;
+#endif
         using rgb_t = cgi::type::color_t;
     }
 
+    /// @brief channel packing and extraction. everything is constexpr and allocation free, so colors can be built at compile time
     namespace color
     {
-        inline static cgi::type::color_t rgb(int r, int g, int b)
+        constexpr cgi::type::color_t rgb(int r, int g, int b) noexcept
         {
-            return RGB(r, g, b);
+            return (cgi::type::color_t)((r & 0xff) | ((g & 0xff) << 8) | ((b & 0xff) << 16));
         }
 
-        inline static std::vector<int> parse_rgb(cgi::type::color_t color)
+        /// @brief packs a color with an 8 bit opacity in the top byte (0xAABBGGRR)
+        constexpr cgi::type::color_t rgba(int r, int g, int b, int a) noexcept
         {
-            std::vector<int> rgb_vec;
+            return cgi::color::rgb(r, g, b) | ((cgi::type::color_t)(a & 0xff) << 24);
+        }
 
-            rgb_vec.push_back(GetRValue(color));
-            rgb_vec.push_back(GetGValue(color));
-            rgb_vec.push_back(GetBValue(color));
+        /// @brief splits a color into red, green and blue
+        /// @return {red, green, blue}
+        constexpr std::array<int, 3> parse_rgb(cgi::type::color_t color) noexcept
+        {
+            return {(int)(color & 0xff), (int)((color >> 8) & 0xff), (int)((color >> 16) & 0xff)};
+        }
 
-            return rgb_vec;
+        constexpr int parse_red(cgi::type::color_t color) noexcept
+        {
+            return color & 0xff;
         }
 
-        inline int parse_red(cgi::type::color_t color)
+        constexpr int parse_blue(cgi::type::color_t color) noexcept
         {
-            return GetRValue(color);
+            return (color >> 16) & 0xff;
         }
 
-        inline int parse_blue(cgi::type::color_t color)
+        constexpr int parse_green(cgi::type::color_t color) noexcept
         {
-            return GetBValue(color);
+            return (color >> 8) & 0xff;
         }
 
-        inline int parse_green(cgi::type::color_t color)
+        constexpr int parse_alpha(cgi::type::color_t color) noexcept
         {
-            return GetGValue(color);
+            return (color >> 24) & 0xff;
         }
     }
 }
@@ -69,6 +91,15 @@ namespace cgi
         using base_map_t = char;
         using map_t = std::vector<cgi::type::base_map_t>;
         using map2_t = std::vector<std::vector<char>>;
+
+        /// @brief axis aligned rectangle in pixels, x/y is the top left corner
+        struct rect_t
+        {
+            int x = 0;
+            int y = 0;
+            int width = 0;
+            int height = 0;
+        };
         
 
         class rgba_t
@@ -100,11 +131,14 @@ namespace cgi
                 {
                     alpha = 1;
                 }
-                std::vector<int> vec = cgi::color::parse_rgb(color);
-                this->r = vec[0];
-                this->g = vec[1];
-                this->b = vec[2];
-                this->a = 1;
+                if (alpha < 0)
+                {
+                    alpha = 0;
+                }
+                this->r = cgi::color::parse_red(color);
+                this->g = cgi::color::parse_green(color);
+                this->b = cgi::color::parse_blue(color);
+                this->a = alpha;
                 return;
             }
 
@@ -123,19 +157,116 @@ namespace cgi
                 return this->b;
             }
 
-            const float &alpha()
+            const float &alpha() const
             {
                 return this->a;
             }
 
             inline cgi::type::color_t value()
             {
-                return RGB(r * a, g * a, b * a);
+                return cgi::color::rgb((int)(r * a), (int)(g * a), (int)(b * a));
             }
         };
 
         using buf_rgba_t = std::vector<cgi::type::rgba_t>;
         using buf2_rgba_t = std::vector<cgi::type::buf_rgba_t>;
+
+        /// @brief compact 4 byte rgba color with 8 bit channels, packed like cgi::type::color_t with the opacity in the top byte (0xAABBGGRR). a row of them can be handed to the span kernels as is. whether the channels are premultiplied is up to whoever holds the buffer, see premultiply()
+        struct rgba8_t
+        {
+            cgi::type::color_t value = 0;
+
+            constexpr rgba8_t() = default;
+
+            /// @brief packs 8 bit channels, values outside 0..255 are clamped
+            /// @param red red channel
+            /// @param green green channel
+            /// @param blue blue channel
+            /// @param alpha opacity from 0 to 255
+            constexpr rgba8_t(int red, int green, int blue, int alpha = 255)
+                : value((cgi::type::color_t)clamp8(red) | ((cgi::type::color_t)clamp8(green) << 8) | ((cgi::type::color_t)clamp8(blue) << 16) | ((cgi::type::color_t)clamp8(alpha) << 24))
+            {
+            }
+
+            /// @brief converts an rgba_t, the 0..1 opacity is rounded to 0..255. implicit so rgba_t call sites keep working
+            /// @param color color to convert
+            rgba8_t(const cgi::type::rgba_t &color)
+                : rgba8_t(color.red(), color.green(), color.blue(), !(color.alpha() > 0) ? 0 : (color.alpha() >= 1 ? 255 : (int)(color.alpha() * 255.0f + 0.5f)))
+            {
+            }
+
+            /// @brief wraps an already packed 0xAABBGGRR value
+            static constexpr rgba8_t from_packed(cgi::type::color_t packed)
+            {
+                rgba8_t color;
+                color.value = packed;
+                return color;
+            }
+
+            constexpr int red() const
+            {
+                return (int)(this->value & 0xff);
+            }
+
+            constexpr int green() const
+            {
+                return (int)((this->value >> 8) & 0xff);
+            }
+
+            constexpr int blue() const
+            {
+                return (int)((this->value >> 16) & 0xff);
+            }
+
+            constexpr int alpha() const
+            {
+                return (int)(this->value >> 24);
+            }
+
+            /// @brief multiplies the color channels by the opacity, rounded to nearest
+            /// @return premultiplied color
+            constexpr rgba8_t premultiply() const
+            {
+                return rgba8_t(mul8(this->red(), this->alpha()), mul8(this->green(), this->alpha()), mul8(this->blue(), this->alpha()), this->alpha());
+            }
+
+            /// @brief undoes premultiply(), fully transparent colors become black
+            /// @return straight alpha color
+            constexpr rgba8_t unpremultiply() const
+            {
+                const int a = this->alpha();
+                if (a == 0)
+                    return rgba8_t(0, 0, 0, 0);
+                return rgba8_t((this->red() * 255 + a / 2) / a, (this->green() * 255 + a / 2) / a, (this->blue() * 255 + a / 2) / a, a);
+            }
+
+            constexpr bool operator==(const rgba8_t &other) const
+            {
+                return this->value == other.value;
+            }
+
+            constexpr bool operator!=(const rgba8_t &other) const
+            {
+                return this->value != other.value;
+            }
+
+        private:
+            static constexpr int clamp8(int v)
+            {
+                return v < 0 ? 0 : (v > 255 ? 255 : v);
+            }
+
+            /// @brief v * a / 255 rounded to nearest, same rounding as the blend kernels
+            static constexpr int mul8(int v, int a)
+            {
+                return (v * a + 128 + ((v * a + 128) >> 8)) >> 8;
+            }
+        };
+
+        static_assert(sizeof(cgi::type::rgba8_t) == sizeof(cgi::type::color_t), "rgba8_t must stay one packed pixel");
+
+        using buf_rgba8_t = std::vector<cgi::type::rgba8_t>;
+        using buf2_rgba8_t = std::vector<cgi::type::buf_rgba8_t>;
     }
 
 }
@@ -0,0 +1,267 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_DIRTY_HPP
+#define CGI_DIRTY_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+
+namespace cgi
+{
+    /// @brief bounded set of damaged rectangles. overlapping rectangles are merged as they arrive and when the set is full the two rectangles whose union wastes the fewest pixels are merged, so the set never grows past its limit
+    class dirty_region
+    {
+    public:
+        static constexpr int capacity = 16;
+
+    private:
+        cgi::type::rect_t list[capacity] = {};
+        int count = 0;
+        int limit = 8;
+        bool whole = false;
+
+        int bound_width = 0;
+        int bound_height = 0;
+
+        static inline long long area(const cgi::type::rect_t &r) noexcept
+        {
+            return (long long)r.width * r.height;
+        }
+
+        static inline cgi::type::rect_t unite(const cgi::type::rect_t &a, const cgi::type::rect_t &b) noexcept
+        {
+            const int x0 = std::min(a.x, b.x);
+            const int y0 = std::min(a.y, b.y);
+            const int x1 = std::max(a.x + a.width, b.x + b.width);
+            const int y1 = std::max(a.y + a.height, b.y + b.height);
+            return {x0, y0, x1 - x0, y1 - y0};
+        }
+
+        static inline bool contains(const cgi::type::rect_t &outer, const cgi::type::rect_t &inner) noexcept
+        {
+            return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width && inner.y + inner.height <= outer.y + outer.height;
+        }
+
+        /// @brief extra pixels a merge would cover that neither rectangle covers (negative when they overlap)
+        static inline long long waste(const cgi::type::rect_t &a, const cgi::type::rect_t &b) noexcept
+        {
+            return area(unite(a, b)) - area(a) - area(b);
+        }
+
+        inline void remove_at(int index) noexcept
+        {
+            this->list[index] = this->list[this->count - 1];
+            this->count--;
+        }
+
+        /// @brief stores a clipped rectangle, swallowing every rectangle that merges with it for free
+        void insert(cgi::type::rect_t r) noexcept
+        {
+            for (int i = 0; i < this->count; i++)
+            {
+                if (contains(this->list[i], r))
+                    return;
+            }
+
+            for (int i = 0; i < this->count;)
+            {
+                if (waste(this->list[i], r) <= 0 || contains(r, this->list[i]))
+                {
+                    r = unite(this->list[i], r);
+                    this->remove_at(i);
+                    i = 0;
+                    continue;
+                }
+                i++;
+            }
+
+            if (r.width >= this->bound_width && r.height >= this->bound_height)
+            {
+                this->add_all();
+                return;
+            }
+
+            // the list is full only when the limit is capacity, fold the new rectangle into the one it wastes the fewest pixels with
+            if (this->count == capacity)
+            {
+                int best = 0;
+                for (int i = 1; i < this->count; i++)
+                {
+                    if (waste(this->list[i], r) < waste(this->list[best], r))
+                        best = i;
+                }
+
+                r = unite(this->list[best], r);
+                this->remove_at(best);
+                this->insert(r);
+                return;
+            }
+
+            this->list[this->count++] = r;
+        }
+
+    public:
+        /// @brief sets the area the rectangles are clipped to. resets the region
+        /// @param width width of the surface in pixels
+        /// @param height height of the surface in pixels
+        inline void set_bounds(int width, int height) noexcept
+        {
+            this->bound_width = width;
+            this->bound_height = height;
+            this->reset();
+        }
+
+        /// @brief sets how many rectangles may be kept before merging (1 to capacity)
+        /// @param max_rects maximum rectangle count
+        inline void set_limit(int max_rects) noexcept
+        {
+            this->limit = std::min(std::max(max_rects, 1), capacity);
+            while (this->count > this->limit)
+                this->merge_cheapest();
+        }
+
+        /// @brief forgets all damage
+        inline void reset() noexcept
+        {
+            this->count = 0;
+            this->whole = false;
+        }
+
+        /// @brief marks the whole bounds as damaged
+        inline void add_all() noexcept
+        {
+            this->count = 0;
+            this->whole = this->bound_width > 0 && this->bound_height > 0;
+        }
+
+        /// @brief adds a damaged rectangle, clipped to the bounds
+        /// @param x_pos left of the rectangle
+        /// @param y_pos top of the rectangle
+        /// @param width width in pixels
+        /// @param height height in pixels
+        inline void add(int x_pos, int y_pos, int width, int height) noexcept
+        {
+            if (this->whole)
+                return;
+
+            int x0 = std::max(x_pos, 0);
+            int y0 = std::max(y_pos, 0);
+            int x1 = std::min(x_pos + width, this->bound_width);
+            int y1 = std::min(y_pos + height, this->bound_height);
+
+            if (x0 >= x1 || y0 >= y1)
+                return;
+
+            this->insert({x0, y0, x1 - x0, y1 - y0});
+
+            while (!this->whole && this->count > this->limit)
+                this->merge_cheapest();
+        }
+
+        /// @brief adds a rectangle
+        /// @param rect damaged rectangle
+        inline void add(const cgi::type::rect_t &rect) noexcept
+        {
+            this->add(rect.x, rect.y, rect.width, rect.height);
+        }
+
+        /// @brief merges the pair of rectangles whose union adds the fewest pixels
+        void merge_cheapest() noexcept
+        {
+            if (this->count < 2)
+                return;
+
+            int best_a = 0, best_b = 1;
+            long long best = waste(this->list[0], this->list[1]);
+
+            for (int a = 0; a < this->count; a++)
+            {
+                for (int b = a + 1; b < this->count; b++)
+                {
+                    long long w = waste(this->list[a], this->list[b]);
+                    if (w < best)
+                    {
+                        best = w;
+                        best_a = a;
+                        best_b = b;
+                    }
+                }
+            }
+
+            cgi::type::rect_t merged = unite(this->list[best_a], this->list[best_b]);
+            this->remove_at(best_b);
+            this->remove_at(best_a);
+            this->insert(merged);
+        }
+
+        /// @brief checks if nothing is damaged
+        /// @return true if empty
+        inline bool empty() const noexcept
+        {
+            return !this->whole && this->count == 0;
+        }
+
+        /// @brief checks if the whole bounds are damaged
+        /// @return true if everything is damaged
+        inline bool is_whole() const noexcept
+        {
+            return this->whole;
+        }
+
+        /// @brief used to get the number of rectangles, 1 when the whole bounds are damaged
+        /// @return rectangle count
+        inline int size() const noexcept
+        {
+            return this->whole ? 1 : this->count;
+        }
+
+        /// @brief used to get one rectangle
+        /// @param index 0 to size()-1
+        /// @return the damaged rectangle
+        inline cgi::type::rect_t at(int index) const noexcept
+        {
+            if (this->whole)
+                return {0, 0, this->bound_width, this->bound_height};
+            return this->list[index];
+        }
+
+        /// @brief used to get the smallest rectangle covering all damage
+        /// @return bounding rectangle, empty if nothing is damaged
+        inline cgi::type::rect_t bounds() const noexcept
+        {
+            if (this->whole)
+                return {0, 0, this->bound_width, this->bound_height};
+            if (this->count == 0)
+                return {0, 0, 0, 0};
+
+            cgi::type::rect_t r = this->list[0];
+            for (int i = 1; i < this->count; i++)
+                r = unite(r, this->list[i]);
+            return r;
+        }
+
+        /// @brief used to get the number of pixels covered by the rectangles, an upper bound of the damaged pixels
+        /// @return pixel count
+        inline long long pixel_count() const noexcept
+        {
+            if (this->whole)
+                return (long long)this->bound_width * this->bound_height;
+
+            long long total = 0;
+            for (int i = 0; i < this->count; i++)
+                total += area(this->list[i]);
+            return total;
+        }
+    };
+}
+
+#endif
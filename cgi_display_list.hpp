@@ -0,0 +1,496 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_DISPLAY_LIST_HPP
+#define CGI_DISPLAY_LIST_HPP
+
+#pragma once
+
+#include "cgi_surface.hpp"
+
+namespace cgi
+{
+    /// @brief recorded draw calls for content that rarely changes (backgrounds, ui chrome). recording resolves every call into a few primitives: text is rasterized into a mask, buffers become contiguous images, pixels and lines become fills and neighbouring pixels of one color merge into a single fill. the first replay on a surface size clips every command, turns rows of single pixels into one image, drops what is off screen or hidden under a later opaque fill or image, and keeps the result, so later replays only walk the surviving commands
+    class display_list
+    {
+    private:
+        enum class op
+        {
+            CLEAR,
+            FILL,
+            PIXELS,
+            IMAGE,
+            MASK
+        };
+
+        struct command
+        {
+            op kind = op::FILL;
+            cgi::type::rect_t area = {};
+            cgi::type::color_t color = 0;
+            float alpha = 1.0f;
+            cgi::type::rgba_t fg;
+            std::optional<cgi::type::rgba_t> bg;
+            int payload = -1;
+        };
+
+        std::vector<command> commands;
+        std::vector<cgi::type::image_t> images;
+        std::vector<cgi::type::mask_t> masks;
+        std::vector<cgi::type::buf_color_t> strips;
+
+        // replay form for one surface size
+        std::vector<command> compiled;
+        std::vector<cgi::type::image_t> views;
+        std::vector<cgi::type::image_t> merged;
+        int compiled_width = -1;
+        int compiled_height = -1;
+        bool stale = true;
+
+        // opaque rectangles remembered for culling, bounds the compile cost of long lists
+        static constexpr size_t max_cover = 32;
+
+        static inline bool contains(const cgi::type::rect_t &outer, const cgi::type::rect_t &inner) noexcept
+        {
+            return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width && inner.y + inner.height <= outer.y + outer.height;
+        }
+
+        static inline cgi::type::rect_t clip(const cgi::type::rect_t &r, int width, int height) noexcept
+        {
+            const int x0 = std::max(r.x, 0);
+            const int y0 = std::max(r.y, 0);
+            const int x1 = std::min(r.x + r.width, width);
+            const int y1 = std::min(r.y + r.height, height);
+            return {x0, y0, std::max(x1 - x0, 0), std::max(y1 - y0, 0)};
+        }
+
+        /// @brief appends an opaque pixel. pixels that continue a row become one strip, pixels of the previous fill's color extend that fill
+        void push_pixel(int x_pos, int y_pos, cgi::type::color_t color)
+        {
+            color &= 0x00ffffff;
+
+            if (!this->commands.empty())
+            {
+                command &last = this->commands.back();
+                const bool continues = last.area.height == 1 && last.area.y == y_pos && last.area.x + last.area.width == x_pos;
+
+                if (continues && last.kind == op::PIXELS)
+                {
+                    this->strips[last.payload].push_back(color);
+                    last.area.width++;
+                    this->stale = true;
+                    return;
+                }
+
+                // a single pixel of another color followed by this one starts a strip
+                if (continues && last.kind == op::FILL && last.area.width == 1 && last.color != color && last.alpha >= 1.0f)
+                {
+                    last.kind = op::PIXELS;
+                    last.payload = (int)this->strips.size();
+                    this->strips.push_back({last.color, color});
+                    last.area.width++;
+                    this->stale = true;
+                    return;
+                }
+            }
+
+            this->push_fill(x_pos, y_pos, 1, 1, color, 1.0f);
+        }
+
+        /// @brief the recorded image for a payload index, merged pixel strips come after the recorded images
+        inline const cgi::type::image_t &source(int payload) const noexcept
+        {
+            return payload < (int)this->images.size() ? this->images[payload] : this->merged[payload - this->images.size()];
+        }
+
+        /// @brief turns pixel strips into images. strips recorded one after another with the same x and width on consecutive rows form a single image
+        std::vector<command> resolve_pixels()
+        {
+            this->merged.clear();
+
+            std::vector<command> resolved;
+            resolved.reserve(this->commands.size());
+
+            for (size_t i = 0; i < this->commands.size(); i++)
+            {
+                if (this->commands[i].kind != op::PIXELS)
+                {
+                    resolved.push_back(this->commands[i]);
+                    continue;
+                }
+
+                const cgi::type::rect_t first = this->commands[i].area;
+                size_t end = i + 1;
+                while (end < this->commands.size() && this->commands[end].kind == op::PIXELS && this->commands[end].area.x == first.x && this->commands[end].area.width == first.width && this->commands[end].area.y == first.y + (int)(end - i))
+                    end++;
+
+                cgi::type::image_t image(first.width, (int)(end - i));
+                for (size_t k = i; k < end; k++)
+                {
+                    const cgi::type::buf_color_t &strip = this->strips[this->commands[k].payload];
+                    std::copy(strip.begin(), strip.end(), image.row((int)(k - i)));
+                }
+
+                command c;
+                c.kind = op::IMAGE;
+                c.area = {first.x, first.y, image.width(), image.height()};
+                c.payload = (int)(this->images.size() + this->merged.size());
+                this->merged.push_back(std::move(image));
+                resolved.push_back(c);
+
+                i = end - 1;
+            }
+
+            return resolved;
+        }
+
+        /// @brief appends a fill, or grows the previous fill when it is the same color on the same row and this one continues it
+        void push_fill(int x_pos, int y_pos, int width, int height, cgi::type::color_t color, float alpha)
+        {
+            if (width <= 0 || height <= 0 || cgi::blend::to_alpha8(alpha) == 0)
+                return;
+
+            this->stale = true;
+            color &= 0x00ffffff;
+
+            if (!this->commands.empty() && height == 1)
+            {
+                command &last = this->commands.back();
+                if (last.kind == op::FILL && last.area.height == 1 && last.area.y == y_pos && last.area.x + last.area.width == x_pos && last.color == color && last.alpha == alpha)
+                {
+                    last.area.width += width;
+                    return;
+                }
+            }
+
+            command c;
+            c.kind = op::FILL;
+            c.area = {x_pos, y_pos, width, height};
+            c.color = color;
+            c.alpha = alpha;
+            this->commands.push_back(c);
+        }
+
+        void push_image(int x_pos, int y_pos, cgi::type::image_t image, float alpha)
+        {
+            if (image.empty() || cgi::blend::to_alpha8(alpha) == 0)
+                return;
+
+            this->stale = true;
+
+            command c;
+            c.kind = op::IMAGE;
+            c.area = {x_pos, y_pos, image.width(), image.height()};
+            c.alpha = alpha;
+            c.payload = (int)this->images.size();
+            this->images.push_back(std::move(image));
+            this->commands.push_back(c);
+        }
+
+        void push_mask(int x_pos, int y_pos, cgi::type::mask_t mask, cgi::type::rgba_t color, std::optional<cgi::type::rgba_t> bg_color)
+        {
+            if (mask.width() == 0 || mask.height() == 0)
+                return;
+
+            this->stale = true;
+
+            command c;
+            c.kind = op::MASK;
+            c.area = {x_pos, y_pos, mask.width(), mask.height()};
+            c.fg = color;
+            c.bg = bg_color;
+            c.payload = (int)this->masks.size();
+            this->masks.push_back(std::move(mask));
+            this->commands.push_back(c);
+        }
+
+        /// @brief builds the replay form for a surface size
+        void compile(int width, int height)
+        {
+            this->compiled.clear();
+            this->views.clear();
+
+            const std::vector<command> resolved = this->resolve_pixels();
+
+            // walk backwards so every command is tested against the opaque fills drawn over it
+            std::vector<cgi::type::rect_t> cover;
+
+            for (int i = (int)resolved.size() - 1; i >= 0; i--)
+            {
+                command c = resolved[i];
+
+                // a clear paints everything, nothing recorded before it can show
+                if (c.kind == op::CLEAR)
+                {
+                    this->compiled.push_back(c);
+                    break;
+                }
+
+                const cgi::type::rect_t visible = clip(c.area, width, height);
+                if (visible.width == 0 || visible.height == 0)
+                    continue;
+
+                bool hidden = false;
+                for (const cgi::type::rect_t &r : cover)
+                {
+                    if (contains(r, visible))
+                    {
+                        hidden = true;
+                        break;
+                    }
+                }
+                if (hidden)
+                    continue;
+
+                bool opaque = false;
+                if (c.kind == op::FILL)
+                {
+                    c.area = visible;
+                    opaque = cgi::blend::to_alpha8(c.alpha) == 255;
+                }
+                else if (c.kind == op::IMAGE)
+                {
+                    // only the visible part is kept, the blit then has nothing left to clip
+                    const cgi::type::image_t &image = this->source(c.payload);
+                    this->views.push_back(image.view(visible.x - c.area.x, visible.y - c.area.y, visible.width, visible.height));
+                    c.payload = (int)this->views.size() - 1;
+                    c.area = visible;
+                    opaque = image.alpha_mode() == cgi::type::alpha_mode_t::NONE && cgi::blend::to_alpha8(c.alpha) == 255;
+                }
+
+                // the largest opaque rectangles are kept, they hide the most
+                if (opaque)
+                {
+                    if (cover.size() < max_cover)
+                    {
+                        cover.push_back(visible);
+                    }
+                    else
+                    {
+                        auto smallest = std::min_element(cover.begin(), cover.end(), [](const cgi::type::rect_t &a, const cgi::type::rect_t &b)
+                                                         { return (long long)a.width * a.height < (long long)b.width * b.height; });
+                        if ((long long)smallest->width * smallest->height < (long long)visible.width * visible.height)
+                            *smallest = visible;
+                    }
+                }
+
+                this->compiled.push_back(c);
+            }
+
+            std::reverse(this->compiled.begin(), this->compiled.end());
+
+            this->compiled_width = width;
+            this->compiled_height = height;
+            this->stale = false;
+        }
+
+    public:
+        display_list() = default;
+
+        /// @brief records a clear. everything recorded before it is dropped from replays
+        /// @param clear_color color to clear with
+        void clear(cgi::type::color_t clear_color)
+        {
+            this->stale = true;
+
+            command c;
+            c.kind = op::CLEAR;
+            c.color = clear_color;
+            this->commands.push_back(c);
+        }
+
+        /// @brief records surface::set_pixel
+        void set_pixel(int x_pos, int y_pos, cgi::type::color_t color_rgb, float alpha = 1.0)
+        {
+            if (cgi::blend::to_alpha8(alpha) == 255)
+                this->push_pixel(x_pos, y_pos, color_rgb);
+            else
+                this->push_fill(x_pos, y_pos, 1, 1, color_rgb, alpha);
+        }
+
+        /// @brief records surface::set_pixel
+        void set_pixel(int x_pos, int y_pos, cgi::type::rgba_t color)
+        {
+            const cgi::type::color_t packed = cgi::blend::pack(color);
+            this->set_pixel(x_pos, y_pos, packed, (float)(packed >> 24) / 255.0f);
+        }
+
+        /// @brief records surface::fill_rect
+        void fill_rect(int x_pos, int y_pos, int width, int height, cgi::type::color_t color, float alpha = 1.0)
+        {
+            this->push_fill(x_pos, y_pos, width, height, color, alpha);
+        }
+
+        /// @brief records surface::fill_rect
+        void fill_rect(int x_pos, int y_pos, int width, int height, cgi::type::rgba_t color)
+        {
+            const cgi::type::color_t packed = cgi::blend::pack(color);
+            this->push_fill(x_pos, y_pos, width, height, packed, (float)(packed >> 24) / 255.0f);
+        }
+
+        /// @brief records surface::fill_rect
+        void fill_rect(int x_pos, int y_pos, int width, int height, cgi::type::rgba8_t color)
+        {
+            this->push_fill(x_pos, y_pos, width, height, color.value, (float)color.alpha() / 255.0f);
+        }
+
+        /// @brief records surface::hline
+        void hline(int x_pos, int y_pos, int length, cgi::type::color_t color, float alpha = 1.0)
+        {
+            this->push_fill(x_pos, y_pos, length, 1, color, alpha);
+        }
+
+        /// @brief records surface::vline
+        void vline(int x_pos, int y_pos, int length, cgi::type::color_t color, float alpha = 1.0)
+        {
+            this->push_fill(x_pos, y_pos, 1, length, color, alpha);
+        }
+
+        /// @brief records surface::draw_image. the image shares its pixels with the list, changes to them show in the next replay
+        void draw_image(int x_pos, int y_pos, const cgi::type::image_t &image, float alpha = 1.0)
+        {
+            this->push_image(x_pos, y_pos, image, alpha);
+        }
+
+        /// @brief records surface::draw_buf2_color_t. the buffer is copied into a contiguous image, short rows stay unpainted
+        void draw_buf2_color_t(int x_pos, int y_pos, const cgi::type::buf2_color_t &buffer, float alpha = 1.0)
+        {
+            size_t width = 0;
+            bool ragged = false;
+            for (const cgi::type::buf_color_t &line : buffer)
+            {
+                ragged = ragged || (width != 0 && line.size() != width);
+                width = std::max(width, line.size());
+            }
+
+            if (!ragged)
+            {
+                this->push_image(x_pos, y_pos, cgi::type::image_t::from_buf2_color_t(buffer), alpha);
+                return;
+            }
+
+            // pixels missing from short rows become transparent instead of padding
+            cgi::type::image_t image((int)width, (int)buffer.size(), 0, cgi::type::pixel_format_t::COLORREF, cgi::type::alpha_mode_t::STRAIGHT);
+            for (int y = 0; y < image.height(); y++)
+            {
+                cgi::type::color_t *dst = image.row(y);
+                for (size_t x = 0; x < buffer[y].size(); x++)
+                    dst[x] = (buffer[y][x] & 0x00ffffff) | 0xff000000;
+            }
+            this->push_image(x_pos, y_pos, std::move(image), alpha);
+        }
+
+        /// @brief records surface::draw_buf2_rgba_t. the buffer is copied into a contiguous image
+        void draw_buf2_rgba_t(int x_pos, int y_pos, const cgi::type::buf2_rgba_t &rgba_buffer)
+        {
+            this->push_image(x_pos, y_pos, cgi::type::image_t::from_buf2_rgba_t(rgba_buffer), 1.0f);
+        }
+
+        /// @brief records surface::draw_buf2_rgba8_t. the buffer is copied into a contiguous image
+        void draw_buf2_rgba8_t(int x_pos, int y_pos, const cgi::type::buf2_rgba8_t &rgba_buffer, cgi::type::alpha_mode_t alpha = cgi::type::alpha_mode_t::STRAIGHT)
+        {
+            this->push_image(x_pos, y_pos, cgi::type::image_t::from_buf2_rgba8_t(rgba_buffer, alpha), 1.0f);
+        }
+
+        /// @brief records surface::draw_mask. the mask is copied
+        void draw_mask(int x_pos, int y_pos, const cgi::type::mask_t &mask, cgi::type::rgba_t color, std::optional<cgi::type::rgba_t> bg_color = std::nullopt)
+        {
+            this->push_mask(x_pos, y_pos, mask, color, bg_color);
+        }
+
+        /// @brief records surface::draw_text. the text is rasterized once now
+        void draw_text(int x_pos, int y_pos, std::string_view text, const cgi::type::font_t &font, cgi::type::rgba_t color, int scale = 1, int spacing = 1, std::optional<cgi::type::rgba_t> bg_color = std::nullopt)
+        {
+            if (font.empty() || scale <= 0 || text.empty())
+                return;
+
+            cgi::type::mask_t mask;
+            cgi::text_cache::rasterize(mask, text, font, scale, std::max(spacing, 0));
+            this->push_mask(x_pos, y_pos, std::move(mask), color, bg_color);
+        }
+
+        /// @brief records surface::draw_text with the built in font
+        void draw_text(int x_pos, int y_pos, std::string_view text, cgi::type::rgba_t color, int scale = 1, int spacing = 1, std::optional<cgi::type::rgba_t> bg_color = std::nullopt)
+        {
+            this->draw_text(x_pos, y_pos, text, cgi::type::font_t::standard(), color, scale, spacing, bg_color);
+        }
+
+        /// @brief draws the list. the first replay on a new surface size (or after invalidate) clips and culls the commands, later ones reuse that work
+        /// @param target surface to draw into, e.g. a cgi::window
+        void replay(cgi::surface &target)
+        {
+            const int width = target.get_surface_width();
+            const int height = target.get_surface_height();
+
+            if (this->stale || width != this->compiled_width || height != this->compiled_height)
+                this->compile(width, height);
+
+            for (const command &c : this->compiled)
+            {
+                switch (c.kind)
+                {
+                case op::CLEAR:
+                    target.clear(c.color);
+                    break;
+                case op::FILL:
+                    target.fill_rect(c.area.x, c.area.y, c.area.width, c.area.height, c.color, c.alpha);
+                    break;
+                case op::PIXELS:
+                    break;
+                case op::IMAGE:
+                    target.draw_image(c.area.x, c.area.y, this->views[c.payload], c.alpha);
+                    break;
+                case op::MASK:
+                    target.draw_mask(c.area.x, c.area.y, this->masks[c.payload], c.fg, c.bg);
+                    break;
+                }
+            }
+        }
+
+        /// @brief forces the next replay to clip and cull again, e.g. after drawing into an image the list holds changed what is opaque
+        inline void invalidate() noexcept
+        {
+            this->stale = true;
+        }
+
+        /// @brief drops every recorded command so the list can be recorded again
+        void reset() noexcept
+        {
+            this->commands.clear();
+            this->images.clear();
+            this->masks.clear();
+            this->strips.clear();
+            this->compiled.clear();
+            this->views.clear();
+            this->merged.clear();
+            this->stale = true;
+        }
+
+        /// @brief checks if nothing is recorded
+        inline bool empty() const noexcept
+        {
+            return this->commands.empty();
+        }
+
+        /// @brief used to get the number of recorded commands after merging
+        inline size_t size() const noexcept
+        {
+            return this->commands.size();
+        }
+
+        /// @brief used to get the number of commands the last replay ran after clipping and culling
+        inline size_t replay_size() const noexcept
+        {
+            return this->compiled.size();
+        }
+    };
+}
+
+#endif
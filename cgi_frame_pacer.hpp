@@ -0,0 +1,321 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_FRAME_PACER_HPP
+#define CGI_FRAME_PACER_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+#include <chrono>
+#include <thread>
+
+// older mingw-w64 and windows sdk headers predate high resolution waitable timers
+#if defined(_WIN32) && !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace cgi
+{
+    /// @brief keeps a frame loop on a fixed schedule of deadlines and records how well it keeps it. deadlines advance by one period each frame so small errors do not add up, a frame that overruns by a whole period starts a new schedule instead of rushing to catch up
+    class frame_pacer
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        /// @brief number of frames the rolling statistics cover
+        static constexpr int window = 128;
+
+    private:
+        cgi::type::pacing_t mode = cgi::type::pacing_t::HYBRID;
+        long long period = 0;
+        long long tolerance = 100000;
+
+        clock::time_point deadline;
+        clock::time_point last_wake;
+        bool started = false;
+
+        // hybrid tuning, the margin is the largest recent sleep overshoot plus some slack
+        static constexpr int sleep_samples = 32;
+        long long sleep_error[sleep_samples] = {};
+        int sleep_at = 0;
+        long long margin = 2000000;
+
+        // rolling frame statistics
+        long long lateness[window] = {};
+        long long interval[window] = {};
+        int samples = 0;
+        int sample_at = 0;
+        unsigned long long total_frames = 0;
+        unsigned long long total_misses = 0;
+
+#ifdef _WIN32
+        HANDLE timer = nullptr;
+#endif
+
+        static inline long long ns(clock::duration d) noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+        }
+
+        /// @brief coarse sleep, a high resolution waitable timer on windows when the os has one
+        void sleep_for_ns(long long duration)
+        {
+            if (duration <= 0)
+                return;
+
+#ifdef _WIN32
+            if (this->timer)
+            {
+                LARGE_INTEGER due;
+                due.QuadPart = -(duration / 100);
+                if (due.QuadPart < 0 && SetWaitableTimer(this->timer, &due, 0, nullptr, nullptr, FALSE))
+                {
+                    WaitForSingleObject(this->timer, INFINITE);
+                    return;
+                }
+            }
+#endif
+            std::this_thread::sleep_for(std::chrono::nanoseconds(duration));
+        }
+
+        void record_sleep_error(long long error) noexcept
+        {
+            this->sleep_error[this->sleep_at] = std::max(error, 0LL);
+            this->sleep_at = (this->sleep_at + 1) % sleep_samples;
+
+            long long worst = 0;
+            for (long long e : this->sleep_error)
+                worst = std::max(worst, e);
+
+            // 50 us of slack on top of the worst recent overshoot, never more than a whole period
+            this->margin = std::max(worst + 50000, 100000LL);
+            if (this->period > 0)
+                this->margin = std::min(this->margin, this->period);
+        }
+
+        void record_frame(long long late, long long gap) noexcept
+        {
+            this->lateness[this->sample_at] = late;
+            this->interval[this->sample_at] = gap;
+            this->sample_at = (this->sample_at + 1) % window;
+            this->samples = std::min(this->samples + 1, window);
+
+            this->total_frames++;
+            if (late > this->tolerance)
+                this->total_misses++;
+        }
+
+    public:
+        frame_pacer()
+        {
+#ifdef _WIN32
+            this->timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+            // windows before 10 1803 rejects the flag, a plain timer still beats sleep_for
+            if (!this->timer)
+                this->timer = CreateWaitableTimerW(nullptr, FALSE, nullptr);
+#endif
+        }
+
+        frame_pacer(const frame_pacer &) = delete;
+        frame_pacer &operator=(const frame_pacer &) = delete;
+
+        ~frame_pacer()
+        {
+#ifdef _WIN32
+            if (this->timer)
+                CloseHandle(this->timer);
+#endif
+        }
+
+        /// @brief sets the target rate and starts a new schedule
+        /// @param refresh_rate frames per second, 0 or less runs uncapped whatever the mode
+        void set_rate(double refresh_rate) noexcept
+        {
+            this->period = refresh_rate > 0 ? (long long)(1e9 / refresh_rate) : 0;
+            this->started = false;
+        }
+
+        /// @brief sets how the pacer waits
+        /// @param pacing UNCAPPED, SLEEP or HYBRID (default)
+        void set_mode(cgi::type::pacing_t pacing) noexcept
+        {
+            this->mode = pacing;
+            this->started = false;
+        }
+
+        inline cgi::type::pacing_t get_mode() const noexcept
+        {
+            return this->mode;
+        }
+
+        /// @brief sets how late a frame may wake before it counts as a missed deadline
+        /// @param seconds tolerance in seconds (default 100 us)
+        void set_miss_tolerance(double seconds) noexcept
+        {
+            this->tolerance = (long long)(std::max(seconds, 0.0) * 1e9);
+        }
+
+        /// @brief starts a new schedule, the first deadline is one period from now. call after the loop was idle so the idle time is not counted as a late frame
+        void reset() noexcept
+        {
+            this->started = true;
+            this->deadline = clock::now();
+            this->last_wake = this->deadline;
+        }
+
+        /// @brief call once at the end of every frame. waits for the frame's deadline and records the timing
+        void wait()
+        {
+            clock::time_point now = clock::now();
+
+            if (!this->started)
+            {
+                this->started = true;
+                this->deadline = now;
+                this->last_wake = now;
+            }
+
+            if (this->period <= 0 || this->mode == cgi::type::pacing_t::UNCAPPED)
+            {
+                this->record_frame(0, ns(now - this->last_wake));
+                this->last_wake = now;
+                return;
+            }
+
+            this->deadline += std::chrono::nanoseconds(this->period);
+
+            // overran by more than a frame, start again from here instead of spinning through a backlog of deadlines
+            if (now - this->deadline > std::chrono::nanoseconds(this->period))
+            {
+                this->record_frame(ns(now - this->deadline), ns(now - this->last_wake));
+                this->deadline = now;
+                this->last_wake = now;
+                return;
+            }
+
+            if (this->mode == cgi::type::pacing_t::SLEEP)
+            {
+                if (now < this->deadline)
+                    std::this_thread::sleep_until(this->deadline);
+            }
+            else
+            {
+                const long long remaining = ns(this->deadline - now) - this->margin;
+                if (remaining > 0)
+                {
+                    this->sleep_for_ns(remaining);
+                    const clock::time_point woke = clock::now();
+                    this->record_sleep_error(ns(woke - now) - remaining);
+                }
+
+                while (clock::now() < this->deadline)
+                    std::this_thread::yield();
+            }
+
+            now = clock::now();
+            this->record_frame(ns(now - this->deadline), ns(now - this->last_wake));
+            this->last_wake = now;
+        }
+
+        /// @brief used to get the target period
+        /// @return seconds per frame, 0 when uncapped
+        inline double target_period() const noexcept
+        {
+            return (double)this->period / 1e9;
+        }
+
+        /// @brief used to get the time between the last two frames
+        /// @return period in seconds
+        inline double frame_period() const noexcept
+        {
+            if (this->samples == 0)
+                return 0;
+            return (double)this->interval[(this->sample_at + window - 1) % window] / 1e9;
+        }
+
+        /// @brief used to get the spin margin the hybrid mode currently uses
+        /// @return margin in seconds
+        inline double spin_margin() const noexcept
+        {
+            return (double)this->margin / 1e9;
+        }
+
+        /// @brief number of frames in the rolling window that woke later than the tolerance
+        /// @return missed deadlines
+        int deadline_misses() const noexcept
+        {
+            int misses = 0;
+            for (int i = 0; i < this->samples; i++)
+            {
+                if (this->lateness[i] > this->tolerance)
+                    misses++;
+            }
+            return misses;
+        }
+
+        /// @brief number of frames that missed their deadline since the pacer was created
+        inline unsigned long long total_deadline_misses() const noexcept
+        {
+            return this->total_misses;
+        }
+
+        /// @brief number of frames paced since the pacer was created
+        inline unsigned long long frame_count() const noexcept
+        {
+            return this->total_frames;
+        }
+
+        /// @brief standard deviation of the frame period over the rolling window
+        /// @return jitter in seconds
+        double jitter() const noexcept
+        {
+            if (this->samples < 2)
+                return 0;
+
+            double mean = 0;
+            for (int i = 0; i < this->samples; i++)
+                mean += (double)this->interval[i];
+            mean /= this->samples;
+
+            double variance = 0;
+            for (int i = 0; i < this->samples; i++)
+                variance += ((double)this->interval[i] - mean) * ((double)this->interval[i] - mean);
+
+            return std::sqrt(variance / (this->samples - 1)) / 1e9;
+        }
+
+        /// @brief average time frames woke after their deadline over the rolling window
+        /// @return lateness in seconds
+        double mean_lateness() const noexcept
+        {
+            if (this->samples == 0)
+                return 0;
+
+            double total = 0;
+            for (int i = 0; i < this->samples; i++)
+                total += (double)this->lateness[i];
+            return total / this->samples / 1e9;
+        }
+
+        /// @brief worst time a frame woke after its deadline over the rolling window
+        /// @return lateness in seconds
+        double max_lateness() const noexcept
+        {
+            long long worst = 0;
+            for (int i = 0; i < this->samples; i++)
+                worst = std::max(worst, this->lateness[i]);
+            return (double)worst / 1e9;
+        }
+    };
+}
+
+#endif
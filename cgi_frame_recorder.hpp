@@ -0,0 +1,468 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_FRAME_RECORDER_HPP
+#define CGI_FRAME_RECORDER_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cgi
+{
+    /// @brief records presented frames to disk without stalling the frame loop. submit() copies a frame into one of a fixed ring of buffers allocated by start() and returns, a writer thread encodes the buffers in order and writes them as raw video, a ppm sequence or a qoi sequence. when every buffer is still waiting the frame is dropped and counted, or submit() waits, depending on the backpressure policy. one thread submits
+    class frame_recorder
+    {
+    private:
+        struct slot
+        {
+            std::vector<cgi::type::color_t> pixels;
+            int width = 0;
+            int height = 0;
+            bool bgra = false;
+            unsigned long long index = 0;
+        };
+
+        std::vector<slot> slots;
+        int head = 0;
+        int queued = 0;
+
+        std::mutex lock;
+        std::condition_variable ready;
+        std::condition_variable released;
+        std::thread worker;
+        bool stopping = false;
+
+        std::string path;
+        cgi::type::record_format_t format = cgi::type::record_format_t::RAW;
+        int frame_width = 0;
+        int frame_height = 0;
+        std::atomic<cgi::type::backpressure_t> policy{cgi::type::backpressure_t::DROP};
+        std::atomic<bool> recording{false};
+
+        // touched by the writer thread only
+        std::ofstream raw_file;
+        std::vector<unsigned char> encoded;
+
+        std::atomic<unsigned long long> submitted{0};
+        std::atomic<unsigned long long> written{0};
+        std::atomic<unsigned long long> dropped{0};
+        std::atomic<unsigned long long> failed{0};
+
+        /// @brief unpacks a surface pixel into r, g, b bytes
+        static inline void rgb(cgi::type::color_t c, bool bgra, unsigned char *out) noexcept
+        {
+            const unsigned char r = (unsigned char)(bgra ? c >> 16 : c);
+            const unsigned char b = (unsigned char)(bgra ? c : c >> 16);
+            out[0] = r;
+            out[1] = (unsigned char)(c >> 8);
+            out[2] = b;
+        }
+
+        void encode_raw(const slot &s)
+        {
+            unsigned char *out = this->encoded.data();
+            for (size_t i = 0, n = (size_t)s.width * s.height; i < n; i++, out += 4)
+            {
+                rgb(s.pixels[i], s.bgra, out);
+                out[3] = 0;
+            }
+        }
+
+        size_t encode_ppm(const slot &s)
+        {
+            const int header = std::snprintf((char *)this->encoded.data(), 32, "P6\n%d %d\n255\n", s.width, s.height);
+
+            unsigned char *out = this->encoded.data() + header;
+            for (size_t i = 0, n = (size_t)s.width * s.height; i < n; i++, out += 3)
+                rgb(s.pixels[i], s.bgra, out);
+
+            return (size_t)(out - this->encoded.data());
+        }
+
+        size_t encode_qoi(const slot &s)
+        {
+            unsigned char *out = this->encoded.data();
+            auto put32 = [&](uint32_t v)
+            {
+                *out++ = (unsigned char)(v >> 24);
+                *out++ = (unsigned char)(v >> 16);
+                *out++ = (unsigned char)(v >> 8);
+                *out++ = (unsigned char)v;
+            };
+
+            *out++ = 'q';
+            *out++ = 'o';
+            *out++ = 'i';
+            *out++ = 'f';
+            put32((uint32_t)s.width);
+            put32((uint32_t)s.height);
+            *out++ = 3;
+            *out++ = 0;
+
+            // frames are opaque, alpha stays 255 and is never encoded. the index still keeps it, an empty entry is transparent black and must not match opaque black
+            unsigned char index[64][4] = {};
+            unsigned char prev[3] = {0, 0, 0};
+            int run = 0;
+
+            const size_t count = (size_t)s.width * s.height;
+            for (size_t i = 0; i < count; i++)
+            {
+                unsigned char px[3];
+                rgb(s.pixels[i], s.bgra, px);
+
+                if (px[0] == prev[0] && px[1] == prev[1] && px[2] == prev[2])
+                {
+                    if (++run == 62)
+                    {
+                        *out++ = (unsigned char)(0xc0 | (run - 1));
+                        run = 0;
+                    }
+                    continue;
+                }
+
+                if (run > 0)
+                {
+                    *out++ = (unsigned char)(0xc0 | (run - 1));
+                    run = 0;
+                }
+
+                const int hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + 255 * 11) % 64;
+                unsigned char *entry = index[hash];
+
+                if (entry[0] == px[0] && entry[1] == px[1] && entry[2] == px[2] && entry[3] == 255)
+                {
+                    *out++ = (unsigned char)hash;
+                }
+                else
+                {
+                    entry[0] = px[0];
+                    entry[1] = px[1];
+                    entry[2] = px[2];
+                    entry[3] = 255;
+
+                    const int dr = (signed char)(px[0] - prev[0]);
+                    const int dg = (signed char)(px[1] - prev[1]);
+                    const int db = (signed char)(px[2] - prev[2]);
+                    const int dr_dg = dr - dg;
+                    const int db_dg = db - dg;
+
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+                    {
+                        *out++ = (unsigned char)(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+                    }
+                    else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7)
+                    {
+                        *out++ = (unsigned char)(0x80 | (dg + 32));
+                        *out++ = (unsigned char)((dr_dg + 8) << 4 | (db_dg + 8));
+                    }
+                    else
+                    {
+                        *out++ = 0xfe;
+                        *out++ = px[0];
+                        *out++ = px[1];
+                        *out++ = px[2];
+                    }
+                }
+
+                prev[0] = px[0];
+                prev[1] = px[1];
+                prev[2] = px[2];
+            }
+
+            if (run > 0)
+                *out++ = (unsigned char)(0xc0 | (run - 1));
+
+            for (int i = 0; i < 7; i++)
+                *out++ = 0;
+            *out++ = 1;
+
+            return (size_t)(out - this->encoded.data());
+        }
+
+        /// @brief encodes and writes one frame, runs on the writer thread
+        bool write(const slot &s)
+        {
+            // worst case is qoi storing every pixel as a 4 byte rgb op
+            const size_t needed = (size_t)s.width * s.height * 4 + 32;
+            if (this->encoded.size() < needed)
+                this->encoded.resize(needed);
+
+            if (this->format == cgi::type::record_format_t::RAW)
+            {
+                this->encode_raw(s);
+                this->raw_file.write((const char *)this->encoded.data(), (std::streamsize)s.width * s.height * 4);
+                return (bool)this->raw_file;
+            }
+
+            const bool ppm = this->format == cgi::type::record_format_t::PPM;
+            const size_t size = ppm ? this->encode_ppm(s) : this->encode_qoi(s);
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "%06llu.%s", s.index, ppm ? "ppm" : "qoi");
+
+            std::ofstream file(this->path + name, std::ios::binary);
+            file.write((const char *)this->encoded.data(), (std::streamsize)size);
+            return (bool)file;
+        }
+
+        void worker_loop()
+        {
+            std::unique_lock<std::mutex> guard(this->lock);
+
+            for (;;)
+            {
+                this->ready.wait(guard, [&]
+                                 { return this->stopping || this->queued > 0; });
+
+                // frames already queued are still written when stopping
+                if (this->queued == 0)
+                    return;
+
+                const slot &next = this->slots[this->head];
+                guard.unlock();
+
+                // the slot at head is never written by submit() while it is counted as queued
+                if (this->write(next))
+                    this->written.fetch_add(1, std::memory_order_relaxed);
+                else
+                    this->failed.fetch_add(1, std::memory_order_relaxed);
+
+                guard.lock();
+                this->head = (this->head + 1) % (int)this->slots.size();
+                this->queued--;
+                this->released.notify_all();
+            }
+        }
+
+    public:
+        frame_recorder() = default;
+
+        frame_recorder(const frame_recorder &) = delete;
+        frame_recorder &operator=(const frame_recorder &) = delete;
+
+        ~frame_recorder()
+        {
+            this->stop();
+        }
+
+        /// @brief allocates the buffers and starts the writer thread, stopping a running recording first
+        /// @param output_path RAW: the file to write. PPM / QOI: prefix of the numbered files, e.g. "capture/frame_" gives capture/frame_000000.ppm, the directory must exist
+        /// @param record_format RAW, PPM or QOI
+        /// @param width expected frame width, buffers are sized for it. RAW files have no header, so RAW frames of any other size are dropped
+        /// @param height expected frame height
+        /// @param buffers frames that may wait to be written (default 8)
+        /// @param backpressure DROP (default) or BLOCK, see cgi::values::BACKPRESSURE
+        /// @return true if recording started
+        bool start(const std::string &output_path, cgi::type::record_format_t record_format, int width, int height, int buffers = 8, cgi::type::backpressure_t backpressure = cgi::type::backpressure_t::DROP)
+        {
+            this->stop();
+
+            if (width <= 0 || height <= 0)
+            {
+                std::cout << "cannot record frames of size " << width << "x" << height << std::endl;
+                return false;
+            }
+
+            this->path = output_path;
+            this->format = record_format;
+            this->frame_width = width;
+            this->frame_height = height;
+            this->policy.store(backpressure, std::memory_order_relaxed);
+
+            if (record_format == cgi::type::record_format_t::RAW)
+            {
+                this->raw_file.open(output_path, std::ios::binary | std::ios::trunc);
+                if (!this->raw_file)
+                {
+                    std::cout << "could not open " << output_path << " for recording" << std::endl;
+                    return false;
+                }
+            }
+
+            // every buffer is allocated up front so recording never allocates unless the frame grows
+            this->slots.assign((size_t)std::max(buffers, 1), slot());
+            for (slot &s : this->slots)
+                s.pixels.resize((size_t)width * height);
+            this->encoded.resize((size_t)width * height * 4 + 32);
+
+            this->head = 0;
+            this->queued = 0;
+            this->stopping = false;
+            this->submitted.store(0, std::memory_order_relaxed);
+            this->written.store(0, std::memory_order_relaxed);
+            this->dropped.store(0, std::memory_order_relaxed);
+            this->failed.store(0, std::memory_order_relaxed);
+
+            try
+            {
+                this->worker = std::thread(&cgi::frame_recorder::worker_loop, this);
+            }
+            catch (...)
+            {
+                std::cout << "could not start the recorder thread" << std::endl;
+                this->raw_file.close();
+                this->slots.clear();
+                return false;
+            }
+
+            this->recording.store(true, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief stops recording. frames already queued are written first, then the buffers are freed
+        void stop()
+        {
+            if (!this->worker.joinable())
+                return;
+
+            this->recording.store(false, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> guard(this->lock);
+                this->stopping = true;
+            }
+            this->ready.notify_all();
+            this->released.notify_all();
+            this->worker.join();
+
+            this->raw_file.close();
+            this->slots.clear();
+            this->slots.shrink_to_fit();
+            this->encoded = std::vector<unsigned char>();
+            this->queued = 0;
+        }
+
+        /// @brief checks if a recording is running
+        inline bool is_recording() const noexcept
+        {
+            return this->recording.load(std::memory_order_acquire);
+        }
+
+        /// @brief changes the backpressure policy of a running recording
+        inline void set_backpressure(cgi::type::backpressure_t backpressure) noexcept
+        {
+            this->policy.store(backpressure, std::memory_order_relaxed);
+        }
+
+        inline cgi::type::backpressure_t get_backpressure() const noexcept
+        {
+            return this->policy.load(std::memory_order_relaxed);
+        }
+
+        /// @brief copies a frame into a free buffer and queues it for writing. with DROP the frame is skipped when no buffer is free, with BLOCK this waits for one
+        /// @param pixels first pixel of the frame
+        /// @param width width of the frame in pixels
+        /// @param height height of the frame in pixels
+        /// @param stride distance between rows in pixels
+        /// @param pixel_format COLORREF or BGRA layout of the pixels
+        /// @return true if the frame was queued, false if it was dropped or nothing is recording. RAW recordings also drop frames whose size differs from the one given to start()
+        bool submit(const cgi::type::color_t *pixels, int width, int height, int stride, cgi::type::pixel_format_t pixel_format = cgi::type::pixel_format_t::COLORREF)
+        {
+            if (!this->is_recording() || !pixels || width <= 0 || height <= 0)
+                return false;
+
+            // dropped frames still use up an index so the gaps show in the file names
+            const unsigned long long index = this->submitted.fetch_add(1, std::memory_order_relaxed);
+
+            // a raw stream is only parseable while every frame has the same size
+            if (this->format == cgi::type::record_format_t::RAW && (width != this->frame_width || height != this->frame_height))
+            {
+                this->dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            std::unique_lock<std::mutex> guard(this->lock);
+
+            if (this->policy.load(std::memory_order_relaxed) == cgi::type::backpressure_t::BLOCK)
+                this->released.wait(guard, [&]
+                                    { return this->stopping || this->queued < (int)this->slots.size(); });
+
+            if (this->stopping || this->queued == (int)this->slots.size())
+            {
+                this->dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            slot &s = this->slots[(this->head + this->queued) % this->slots.size()];
+            guard.unlock();
+
+            // only a ppm or qoi frame larger than the buffer allocates, e.g. after the window grew
+            const size_t count = (size_t)width * height;
+            if (s.pixels.size() < count)
+                s.pixels.resize(count);
+
+            s.width = width;
+            s.height = height;
+            s.bgra = pixel_format == cgi::type::pixel_format_t::BGRA;
+            s.index = index;
+
+            for (int y = 0; y < height; y++)
+            {
+                const cgi::type::color_t *src = pixels + (size_t)y * stride;
+                std::copy(src, src + width, s.pixels.data() + (size_t)y * width);
+            }
+
+            guard.lock();
+            this->queued++;
+            this->ready.notify_one();
+
+            return true;
+        }
+
+        /// @brief waits until every queued frame has been written
+        void flush()
+        {
+            std::unique_lock<std::mutex> guard(this->lock);
+            this->released.wait(guard, [&]
+                                { return !this->worker.joinable() || this->queued == 0; });
+        }
+
+        /// @brief used to get the number of frames waiting to be written
+        inline int in_flight() noexcept
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            return this->queued;
+        }
+
+        /// @brief number of frames offered to submit() since start
+        inline unsigned long long submitted_count() const noexcept
+        {
+            return this->submitted.load(std::memory_order_relaxed);
+        }
+
+        /// @brief number of frames written to disk since start
+        inline unsigned long long written_count() const noexcept
+        {
+            return this->written.load(std::memory_order_relaxed);
+        }
+
+        /// @brief number of frames skipped because no buffer was free, or because a RAW frame had the wrong size
+        inline unsigned long long dropped_count() const noexcept
+        {
+            return this->dropped.load(std::memory_order_relaxed);
+        }
+
+        /// @brief number of frames that could not be written, e.g. a full disk
+        inline unsigned long long failed_count() const noexcept
+        {
+            return this->failed.load(std::memory_order_relaxed);
+        }
+    };
+}
+
+#endif
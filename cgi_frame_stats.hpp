@@ -0,0 +1,173 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_FRAME_STATS_HPP
+#define CGI_FRAME_STATS_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+
+namespace cgi
+{
+    namespace type
+    {
+        /// @brief summary of one frame phase over the recorded samples, times in seconds
+        struct phase_stats_t
+        {
+            int count = 0;
+            double min = 0;
+            double mean = 0;
+            double p50 = 0;
+            double p95 = 0;
+            double p99 = 0;
+            double max = 0;
+        };
+    }
+
+    /// @brief fixed size rings of per phase frame timings. recording is two clock reads and a store under an uncontended lock, summaries sort a copy on the stack, nothing allocates. the lock lets a present thread record its phases while the main thread records the others and the app reads summaries
+    class frame_stats
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        /// @brief samples kept per phase
+        static constexpr int capacity = 512;
+
+        static constexpr int phase_count = (int)cgi::type::phase_t::COUNT;
+
+    private:
+        struct ring
+        {
+            long long samples[capacity] = {};
+            int count = 0;
+            int at = 0;
+        };
+
+        ring phases[phase_count];
+        mutable std::mutex lock;
+
+    public:
+        /// @brief stores one sample
+        /// @param phase phase the time was spent in
+        /// @param nanoseconds duration of the phase
+        inline void record(cgi::type::phase_t phase, long long nanoseconds) noexcept
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            ring &r = this->phases[(int)phase];
+            r.samples[r.at] = nanoseconds;
+            r.at = (r.at + 1) % capacity;
+            r.count = std::min(r.count + 1, capacity);
+        }
+
+        /// @brief records the time since start and returns now, so consecutive phases can be chained
+        /// @param phase phase that just ended
+        /// @param start when the phase began
+        /// @return the end of the phase, i.e. the start of the next one
+        inline clock::time_point lap(cgi::type::phase_t phase, clock::time_point start) noexcept
+        {
+            const clock::time_point now = clock::now();
+            this->record(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count());
+            return now;
+        }
+
+        /// @brief summarizes the recorded samples of a phase
+        /// @param phase phase to summarize
+        /// @return min, mean, percentiles and max in seconds, all 0 when nothing was recorded
+        cgi::type::phase_stats_t summary(cgi::type::phase_t phase) const noexcept
+        {
+            cgi::type::phase_stats_t out;
+            long long sorted[capacity];
+            int count = 0;
+
+            // only the copy is taken under the lock, sorting happens outside it
+            {
+                std::lock_guard<std::mutex> guard(this->lock);
+                const ring &r = this->phases[(int)phase];
+                count = r.count;
+                std::copy(r.samples, r.samples + count, sorted);
+            }
+
+            out.count = count;
+            if (count == 0)
+                return out;
+
+            std::sort(sorted, sorted + count);
+
+            double total = 0;
+            for (int i = 0; i < count; i++)
+                total += (double)sorted[i];
+
+            // nearest rank percentile
+            auto rank = [&](double p)
+            {
+                const int index = (int)std::ceil(p * count) - 1;
+                return (double)sorted[std::min(std::max(index, 0), count - 1)] / 1e9;
+            };
+
+            out.min = (double)sorted[0] / 1e9;
+            out.mean = total / count / 1e9;
+            out.p50 = rank(0.50);
+            out.p95 = rank(0.95);
+            out.p99 = rank(0.99);
+            out.max = (double)sorted[count - 1] / 1e9;
+
+            return out;
+        }
+
+        /// @brief used to get the most recent sample of a phase
+        /// @return duration in seconds, 0 when nothing was recorded
+        inline double last(cgi::type::phase_t phase) const noexcept
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            const ring &r = this->phases[(int)phase];
+            if (r.count == 0)
+                return 0;
+            return (double)r.samples[(r.at + capacity - 1) % capacity] / 1e9;
+        }
+
+        /// @brief forgets every sample
+        void reset() noexcept
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            for (ring &r : this->phases)
+            {
+                r.count = 0;
+                r.at = 0;
+            }
+        }
+
+        /// @brief prints a table of every phase that has samples, in milliseconds
+        /// @param out stream to print to
+        void print(std::ostream &out = std::cout) const
+        {
+            static const char *names[phase_count] = {"pump", "update", "load_view", "blit", "wait", "frame"};
+
+            out << "phase        count      min     mean      p50      p95      p99      max (ms)" << '\n';
+            for (int i = 0; i < phase_count; i++)
+            {
+                const cgi::type::phase_stats_t s = this->summary((cgi::type::phase_t)i);
+                if (s.count == 0)
+                    continue;
+
+                char line[128];
+                std::snprintf(line, sizeof(line), "%-10s %7d %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f", names[i], s.count,
+                              s.min * 1e3, s.mean * 1e3, s.p50 * 1e3, s.p95 * 1e3, s.p99 * 1e3, s.max * 1e3);
+                out << line << '\n';
+            }
+            out << std::flush;
+        }
+    };
+}
+
+#endif
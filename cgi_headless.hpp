@@ -0,0 +1,206 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_HEADLESS_HPP
+#define CGI_HEADLESS_HPP
+
+#pragma once
+
+#include "cgi_surface.hpp"
+#include "cgi_display_list.hpp"
+#include "cgi_frame_pacer.hpp"
+#include "cgi_frame_stats.hpp"
+#include "cgi_frame_recorder.hpp"
+#include <chrono>
+#include <thread>
+
+namespace cgi
+{
+
+    /// @brief off-screen present target. same drawing api as cgi::window but the frame stays in memory, so scenes can be rendered, profiled and load tested without a display. each one owns its surface, pacer and stats, so separate instances can draw on separate threads. they do share the engine thread pool (a job submitted while it is busy runs inline on the caller) and the process wide blend mode and path, so cgi::engine::set_thread_count, cgi::blend::set_mode and cgi::blend::set_path must only be called while no surface is drawing
+    class headless : public cgi::surface
+    {
+    private:
+        const char *name;
+
+        bool open = false;
+
+        double last_frame_period = 0;
+        unsigned long long presented_frames = 0;
+        cgi::dirty_region presented_damage;
+
+        cgi::frame_pacer pacer;
+        cgi::frame_stats stats;
+
+        cgi::frame_recorder *recorder = nullptr;
+
+    public:
+        /// @brief creates an off-screen surface
+        /// @param name name used in log messages
+        /// @param width width of the surface in pixels
+        /// @param height height of the surface in pixels
+        /// @param color base color of the surface
+        headless(const char *name, int width, int height, cgi::type::color_t color) : cgi::surface(width, height, color)
+        {
+            this->name = name;
+            this->open = true;
+        }
+
+        /// @brief checks if the headless target is still running
+        /// @return true while open
+        inline bool is_open() noexcept
+        {
+            return this->open;
+        }
+
+        /// @brief stops a running loop after the current frame
+        void close() noexcept
+        {
+            this->open = false;
+        }
+
+        /// @brief gets the buffer width i.e. the drawable width
+        /// @return width of the surface in pixels
+        inline long int get_buffer_width() noexcept
+        {
+            return this->geometry.width;
+        }
+
+        /// @brief gets the buffer height i.e. the drawable height
+        /// @return height of the surface in pixels
+        inline long int get_buffer_height() noexcept
+        {
+            return this->geometry.height;
+        }
+
+        /// @brief direectly return the pointer to the internal buffer of the surface. address changes on resize so always check before using
+        /// @return the address of the internal buffer or nullptr if the surface is attached to outside memory
+        inline cgi::type::buf_color_t *get_buffer() noexcept
+        {
+            if (this->attached)
+                return nullptr;
+
+            // writes through the vector are not tracked, so assume everything changes
+            this->touch_all();
+            return &this->buffer;
+        }
+
+        /// @brief marks the end of a frame. nothing is shown, the frame just stays readable through get_pixel() or get_buffer()
+        inline void buffer_refresh() noexcept
+        {
+            if (this->recorder && this->recorder->is_recording())
+                this->recorder->submit(this->pixels, this->geometry.width, this->geometry.height, this->geometry.stride, this->format);
+
+            this->presented_damage = this->damage;
+            this->damage.reset();
+            this->presented_frames++;
+        }
+
+        /// @brief attaches a frame recorder, every frame passed to buffer_refresh is copied to it while it records. the recorder is not owned and must outlive the headless target or be detached
+        /// @param frame_recorder recorder to feed, nullptr detaches
+        inline void set_recorder(cgi::frame_recorder *frame_recorder) noexcept
+        {
+            this->recorder = frame_recorder;
+        }
+
+        /// @brief used to get the regions the last buffer_refresh() would have uploaded on a real window
+        /// @return constant reference to the damage of the last presented frame
+        inline const cgi::dirty_region &get_presented_damage() const noexcept
+        {
+            return this->presented_damage;
+        }
+
+        /// @brief used to get the number of frames presented so far
+        /// @return count of presented frames
+        inline unsigned long long frame_count() noexcept
+        {
+            return this->presented_frames;
+        }
+
+        /// @brief runs the update function every frame until close() is called
+        /// @param update_function pointer the function of execution loop
+        /// @param refresh_rate refresh rate, 0 or less runs uncapped (default uncapped)
+        void run_as(void (*update_function)(), double refresh_rate = 0)
+        {
+            this->run_for(update_function, 0, refresh_rate);
+        }
+
+        /// @brief runs the update function for a fixed number of frames, useful for benchmarks
+        /// @param update_function pointer the function of execution loop
+        /// @param frames number of frames to run, 0 runs until close() is called
+        /// @param refresh_rate refresh rate, 0 or less runs uncapped (default uncapped)
+        void run_for(void (*update_function)(), unsigned long long frames, double refresh_rate = 0)
+        {
+            if (!this->is_open())
+            {
+                std::cout << "cannot execute(run) a closed headless surface " << this->name << std::endl;
+                return;
+            }
+
+            this->pacer.set_rate(refresh_rate);
+
+            unsigned long long ran = 0;
+
+            while (this->is_open() && (frames == 0 || ran < frames))
+            {
+                const auto frame_start = std::chrono::steady_clock::now();
+
+                update_function();
+
+                this->buffer_refresh();
+
+                auto lap = this->stats.lap(cgi::type::phase_t::UPDATE, frame_start);
+
+                this->pacer.wait();
+
+                auto end = this->stats.lap(cgi::type::phase_t::WAIT, lap);
+                this->stats.record(cgi::type::phase_t::FRAME, std::chrono::duration_cast<std::chrono::nanoseconds>(end - frame_start).count());
+                this->last_frame_period = this->pacer.frame_period() * 1e9;
+
+                ran++;
+            }
+        }
+
+        /// @brief used to get the time period between each frames
+        /// @return gets the time period between the frame in seconds
+        inline double frame_period() noexcept
+        {
+            return (double)this->last_frame_period / 1e9;
+        }
+
+        /// @brief used to get the pacer that times run_as and run_for. change its mode or read its deadline miss and jitter statistics
+        /// @return reference to the frame pacer
+        inline cgi::frame_pacer &get_frame_pacer() noexcept
+        {
+            return this->pacer;
+        }
+
+        /// @brief used to get the per phase timings of run_as and run_for (update, wait, frame)
+        /// @return reference to the frame statistics
+        inline cgi::frame_stats &get_frame_stats() noexcept
+        {
+            return this->stats;
+        }
+
+        /// @brief used to get the fps of the headless loop
+        /// @return frames per second of the last frame
+        inline double fps() noexcept
+        {
+            if (this->last_frame_period == 0)
+            {
+                return 0;
+            }
+
+            return (double)1 / frame_period();
+        }
+    };
+}
+
+#endif
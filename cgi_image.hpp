@@ -0,0 +1,256 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_IMAGE_HPP
+#define CGI_IMAGE_HPP
+
+#pragma once
+
+#include "cgi_blend.hpp"
+#include <memory>
+#include <new>
+
+namespace cgi
+{
+    namespace type
+    {
+        /// @brief contiguous 32 bit image. every row lives in one 64 byte aligned allocation with a stride rounded up to 64 bytes. copies and sub-image views share the same pixels, use clone() for a deep copy
+        class image_t
+        {
+        public:
+            /// @brief row alignment in bytes
+            static constexpr int alignment = 64;
+
+        private:
+            std::shared_ptr<void> storage;
+            cgi::type::color_t *data = nullptr;
+
+            int w = 0;
+            int h = 0;
+            int pitch = 0;
+
+            cgi::type::pixel_format_t fmt = cgi::type::pixel_format_t::COLORREF;
+            cgi::type::alpha_mode_t alpha = cgi::type::alpha_mode_t::NONE;
+
+            static inline int aligned_stride(int width) noexcept
+            {
+                const int per_line = alignment / (int)sizeof(cgi::type::color_t);
+                return (width + per_line - 1) / per_line * per_line;
+            }
+
+        public:
+            image_t() = default;
+
+            /// @brief allocates an image and fills it
+            /// @param width width in pixels
+            /// @param height height in pixels
+            /// @param fill value stored in every pixel, already in the image's layout
+            /// @param format channel order of the pixels
+            /// @param alpha how the top byte is used
+            image_t(int width, int height, cgi::type::color_t fill = 0, cgi::type::pixel_format_t format = cgi::type::pixel_format_t::COLORREF, cgi::type::alpha_mode_t alpha = cgi::type::alpha_mode_t::NONE)
+            {
+                width = std::max(width, 0);
+                height = std::max(height, 0);
+
+                this->w = width;
+                this->h = height;
+                this->pitch = aligned_stride(width);
+                this->fmt = format;
+                this->alpha = alpha;
+
+                const size_t bytes = (size_t)this->pitch * height * sizeof(cgi::type::color_t);
+                if (bytes == 0)
+                    return;
+
+                void *memory = ::operator new(bytes, std::align_val_t(alignment));
+                this->storage = std::shared_ptr<void>(memory, [](void *p)
+                                                      { ::operator delete(p, std::align_val_t(alignment)); });
+                this->data = (cgi::type::color_t *)memory;
+
+                std::fill(this->data, this->data + (size_t)this->pitch * height, fill);
+            }
+
+            /// @brief wraps pixels owned by someone else without copying, e.g. a memory mapped file
+            /// @param pixels first pixel of the top row
+            /// @param width width in pixels
+            /// @param height height in pixels
+            /// @param stride distance between rows in pixels
+            /// @param format channel order of the pixels
+            /// @param alpha how the top byte is used
+            /// @param owner kept alive as long as the image or any view of it exists (may be empty)
+            /// @return image sharing the given pixels
+            static image_t wrap(cgi::type::color_t *pixels, int width, int height, int stride, cgi::type::pixel_format_t format, cgi::type::alpha_mode_t alpha, std::shared_ptr<void> owner = nullptr)
+            {
+                image_t image;
+                image.storage = std::move(owner);
+                image.data = pixels;
+                image.w = std::max(width, 0);
+                image.h = std::max(height, 0);
+                image.pitch = std::max(stride, image.w);
+                image.fmt = format;
+                image.alpha = alpha;
+                return image;
+            }
+
+            /// @brief converts a nested cgi::type::buf2_color_t, short rows are padded with fill
+            /// @param buffer rows to copy
+            /// @param fill color for pixels missing from short rows
+            /// @return opaque COLORREF image
+            static image_t from_buf2_color_t(const cgi::type::buf2_color_t &buffer, cgi::type::color_t fill = 0)
+            {
+                int width = 0;
+                for (const cgi::type::buf_color_t &line : buffer)
+                    width = std::max(width, (int)line.size());
+
+                image_t image(width, (int)buffer.size(), fill);
+                for (int y = 0; y < image.h; y++)
+                    std::copy(buffer[y].begin(), buffer[y].end(), image.row(y));
+
+                return image;
+            }
+
+            /// @brief converts a nested cgi::type::buf2_rgba_t, short rows are padded with transparent pixels
+            /// @param buffer rows to copy
+            /// @return COLORREF image with straight alpha in the top byte
+            static image_t from_buf2_rgba_t(const cgi::type::buf2_rgba_t &buffer)
+            {
+                int width = 0;
+                for (const cgi::type::buf_rgba_t &line : buffer)
+                    width = std::max(width, (int)line.size());
+
+                image_t image(width, (int)buffer.size(), 0, cgi::type::pixel_format_t::COLORREF, cgi::type::alpha_mode_t::STRAIGHT);
+                for (int y = 0; y < image.h; y++)
+                {
+                    cgi::type::color_t *dst = image.row(y);
+                    for (size_t x = 0; x < buffer[y].size(); x++)
+                        dst[x] = cgi::blend::pack(buffer[y][x]);
+                }
+
+                return image;
+            }
+
+            /// @brief converts a nested cgi::type::buf2_rgba8_t, short rows are padded with transparent pixels
+            /// @param buffer rows to copy
+            /// @param alpha whether the buffer holds straight or premultiplied colors
+            /// @return COLORREF image with the opacity in the top byte
+            static image_t from_buf2_rgba8_t(const cgi::type::buf2_rgba8_t &buffer, cgi::type::alpha_mode_t alpha = cgi::type::alpha_mode_t::STRAIGHT)
+            {
+                int width = 0;
+                for (const cgi::type::buf_rgba8_t &line : buffer)
+                    width = std::max(width, (int)line.size());
+
+                image_t image(width, (int)buffer.size(), 0, cgi::type::pixel_format_t::COLORREF, alpha);
+                for (int y = 0; y < image.h; y++)
+                {
+                    cgi::type::color_t *dst = image.row(y);
+                    for (size_t x = 0; x < buffer[y].size(); x++)
+                        dst[x] = buffer[y][x].value;
+                }
+
+                return image;
+            }
+
+            /// @brief makes a sub-image that shares this image's pixels. the rectangle is clipped to the image
+            /// @param x_pos left of the sub-image
+            /// @param y_pos top of the sub-image
+            /// @param width width in pixels
+            /// @param height height in pixels
+            /// @return view into the same storage
+            image_t view(int x_pos, int y_pos, int width, int height) const
+            {
+                const int x0 = std::min(std::max(x_pos, 0), this->w);
+                const int y0 = std::min(std::max(y_pos, 0), this->h);
+                const int x1 = std::min(std::max(x_pos + width, x0), this->w);
+                const int y1 = std::min(std::max(y_pos + height, y0), this->h);
+
+                image_t sub = *this;
+                sub.data = this->data ? this->data + (size_t)y0 * this->pitch + x0 : nullptr;
+                sub.w = x1 - x0;
+                sub.h = y1 - y0;
+                return sub;
+            }
+
+            /// @brief deep copy into a new tightly aligned allocation
+            /// @return independent image with the same pixels
+            image_t clone() const
+            {
+                image_t copy(this->w, this->h, 0, this->fmt, this->alpha);
+                for (int y = 0; y < this->h; y++)
+                    std::copy(this->row(y), this->row(y) + this->w, copy.row(y));
+                return copy;
+            }
+
+            inline int width() const noexcept
+            {
+                return this->w;
+            }
+
+            inline int height() const noexcept
+            {
+                return this->h;
+            }
+
+            /// @brief used to get the distance between rows
+            /// @return stride in pixels
+            inline int stride() const noexcept
+            {
+                return this->pitch;
+            }
+
+            inline cgi::type::pixel_format_t format() const noexcept
+            {
+                return this->fmt;
+            }
+
+            inline cgi::type::alpha_mode_t alpha_mode() const noexcept
+            {
+                return this->alpha;
+            }
+
+            /// @brief checks if the image has no pixels
+            inline bool empty() const noexcept
+            {
+                return this->w == 0 || this->h == 0;
+            }
+
+            /// @brief used to get a row, no bounds check
+            /// @param y_pos row index
+            /// @return pointer to width() pixels
+            inline cgi::type::color_t *row(int y_pos) noexcept
+            {
+                return this->data + (size_t)y_pos * this->pitch;
+            }
+
+            /// @brief const version of row()
+            inline const cgi::type::color_t *row(int y_pos) const noexcept
+            {
+                return this->data + (size_t)y_pos * this->pitch;
+            }
+
+            /// @brief reads a pixel in the image's own layout, 0 outside the image
+            inline cgi::type::color_t get_pixel(int x_pos, int y_pos) const noexcept
+            {
+                if (x_pos < 0 || x_pos >= this->w || y_pos < 0 || y_pos >= this->h)
+                    return 0;
+                return this->row(y_pos)[x_pos];
+            }
+
+            /// @brief writes a pixel in the image's own layout, ignored outside the image
+            inline void set_pixel(int x_pos, int y_pos, cgi::type::color_t pixel) noexcept
+            {
+                if (x_pos < 0 || x_pos >= this->w || y_pos < 0 || y_pos >= this->h)
+                    return;
+                this->row(y_pos)[x_pos] = pixel;
+            }
+        };
+    }
+}
+
+#endif
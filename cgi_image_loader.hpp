@@ -0,0 +1,630 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_IMAGE_LOADER_HPP
+#define CGI_IMAGE_LOADER_HPP
+
+#pragma once
+
+#include "cgi_image.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cgi
+{
+    /// @brief a whole file mapped into memory copy on write: it can be read and written like a buffer, writes stay private and never reach the file
+    class mapped_file
+    {
+    private:
+        unsigned char *bytes = nullptr;
+        size_t length = 0;
+
+#ifdef _WIN32
+        HANDLE mapping = nullptr;
+#endif
+
+    public:
+        mapped_file() = default;
+
+        explicit mapped_file(const std::string &path)
+        {
+            this->open(path);
+        }
+
+        mapped_file(const mapped_file &) = delete;
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        ~mapped_file()
+        {
+            this->close();
+        }
+
+        /// @brief maps a file, unmapping the current one first
+        /// @param path path of the file
+        /// @return true if the file was mapped, empty files cannot be
+        bool open(const std::string &path)
+        {
+            this->close();
+
+#ifdef _WIN32
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                std::cout << "could not open file " << path << std::endl;
+                return false;
+            }
+
+            LARGE_INTEGER file_size = {};
+            if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+            {
+                std::cout << "could not map empty file " << path << std::endl;
+                CloseHandle(file);
+                return false;
+            }
+
+            // the mapping keeps the file open, the handle itself is not needed any more
+            this->mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            CloseHandle(file);
+
+            if (this->mapping)
+                this->bytes = (unsigned char *)MapViewOfFile(this->mapping, FILE_MAP_COPY, 0, 0, 0);
+
+            if (!this->bytes)
+            {
+                std::cout << "could not map file " << path << std::endl;
+                this->close();
+                return false;
+            }
+
+            this->length = (size_t)file_size.QuadPart;
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                std::cout << "could not open file " << path << std::endl;
+                return false;
+            }
+
+            struct stat info = {};
+            if (fstat(fd, &info) != 0 || info.st_size <= 0)
+            {
+                std::cout << "could not map empty file " << path << std::endl;
+                ::close(fd);
+                return false;
+            }
+
+            void *memory = mmap(nullptr, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+
+            if (memory == MAP_FAILED)
+            {
+                std::cout << "could not map file " << path << std::endl;
+                return false;
+            }
+
+            this->bytes = (unsigned char *)memory;
+            this->length = (size_t)info.st_size;
+#endif
+            return true;
+        }
+
+        /// @brief unmaps the file, images wrapping it must be gone by then
+        void close() noexcept
+        {
+#ifdef _WIN32
+            if (this->bytes)
+                UnmapViewOfFile(this->bytes);
+            if (this->mapping)
+                CloseHandle(this->mapping);
+            this->mapping = nullptr;
+#else
+            if (this->bytes)
+                munmap(this->bytes, this->length);
+#endif
+            this->bytes = nullptr;
+            this->length = 0;
+        }
+
+        inline bool is_open() const noexcept
+        {
+            return this->bytes != nullptr;
+        }
+
+        /// @brief used to get the first byte of the file
+        inline unsigned char *data() noexcept
+        {
+            return this->bytes;
+        }
+
+        inline const unsigned char *data() const noexcept
+        {
+            return this->bytes;
+        }
+
+        /// @brief used to get the size of the file in bytes
+        inline size_t size() const noexcept
+        {
+            return this->length;
+        }
+    };
+
+    /// @brief loaders for uncompressed BMP, binary PPM/PGM and QOI. files are memory mapped and decoded straight into one contiguous cgi::type::image_t, a 32 bit top-down BMP whose pixel data is 4 byte aligned is used straight from the mapping without any copy
+    namespace image_loader
+    {
+        namespace detail
+        {
+            inline uint32_t le16(const unsigned char *p) noexcept
+            {
+                return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+            }
+
+            inline uint32_t le32(const unsigned char *p) noexcept
+            {
+                return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+            }
+
+            inline uint32_t be32(const unsigned char *p) noexcept
+            {
+                return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+            }
+
+            /// @brief packs channels in the cgi::type::color_t layout (0xAABBGGRR)
+            inline cgi::type::color_t pack(uint32_t r, uint32_t g, uint32_t b, uint32_t a) noexcept
+            {
+                return (cgi::type::color_t)(r | (g << 8) | (b << 16) | (a << 24));
+            }
+
+            /// @brief reads an 8 bit channel through a bmp bit mask, 0 for an empty mask
+            inline uint32_t channel(uint32_t pixel, uint32_t mask, int shift) noexcept
+            {
+                return mask ? (pixel & mask) >> shift : 0;
+            }
+
+            inline int mask_shift(uint32_t mask) noexcept
+            {
+                int shift = 0;
+                while (mask && !(mask & 1))
+                {
+                    mask >>= 1;
+                    shift++;
+                }
+                return shift;
+            }
+
+            inline bool is_8_bit_mask(uint32_t mask) noexcept
+            {
+                return mask == 0 || (mask >> mask_shift(mask)) == 0xff;
+            }
+
+            /// @brief allocates the image a decoder writes into
+            /// @return false if the memory could not be allocated
+            inline bool allocate(cgi::type::image_t &image, int width, int height, cgi::type::alpha_mode_t alpha) noexcept
+            {
+                try
+                {
+                    image = cgi::type::image_t(width, height, 0, cgi::type::pixel_format_t::COLORREF, alpha);
+                    return true;
+                }
+                catch (...)
+                {
+                    std::cout << "could not allocate a " << width << "x" << height << " image" << std::endl;
+                    return false;
+                }
+            }
+
+            /// @brief skips whitespace and # comments of a netpbm header and reads the next number
+            inline bool pnm_number(const unsigned char *data, size_t size, size_t &at, uint32_t &value) noexcept
+            {
+                for (;;)
+                {
+                    while (at < size && std::isspace(data[at]))
+                        at++;
+                    if (at < size && data[at] == '#')
+                    {
+                        while (at < size && data[at] != '\n')
+                            at++;
+                        continue;
+                    }
+                    break;
+                }
+
+                if (at >= size || !std::isdigit(data[at]))
+                    return false;
+
+                value = 0;
+                while (at < size && std::isdigit(data[at]))
+                {
+                    value = value * 10 + (data[at] - '0');
+                    if (value > 1u << 24)
+                        return false;
+                    at++;
+                }
+                return true;
+            }
+        }
+
+        /// @brief decodes a BMP held in memory. 24 and 32 bit uncompressed (BI_RGB, BI_BITFIELDS with 8 bit masks), top-down or bottom-up
+        /// @param data first byte of the file
+        /// @param size size of the file in bytes
+        /// @param image receives the pixels
+        /// @param owner when given and the pixel data is already BGRA, top-down and aligned, the image wraps data directly and keeps owner alive instead of copying
+        /// @return true if decoded
+        inline bool decode_bmp(unsigned char *data, size_t size, cgi::type::image_t &image, std::shared_ptr<void> owner = nullptr)
+        {
+            using namespace cgi::image_loader::detail;
+
+            if (size < 54 || data[0] != 'B' || data[1] != 'M')
+            {
+                std::cout << "not a bmp file" << std::endl;
+                return false;
+            }
+
+            const uint32_t offset = le32(data + 10);
+            const uint32_t header = le32(data + 14);
+            if (header < 40 || 14 + (size_t)header > size)
+            {
+                std::cout << "unsupported bmp header" << std::endl;
+                return false;
+            }
+
+            const int32_t width = (int32_t)le32(data + 18);
+            const int32_t signed_height = (int32_t)le32(data + 22);
+            const uint32_t bits = le16(data + 28);
+            const uint32_t compression = le32(data + 30);
+
+            const bool top_down = signed_height < 0;
+            const int64_t height = top_down ? -(int64_t)signed_height : signed_height;
+
+            if (width <= 0 || height <= 0 || width > (1 << 16) || height > (1 << 16) || (bits != 24 && bits != 32) || (compression != 0 && compression != 3 && compression != 6))
+            {
+                std::cout << "unsupported bmp: only uncompressed 24 and 32 bit images are read" << std::endl;
+                return false;
+            }
+
+            // channel masks, BI_RGB 32 bit is plain BGRX
+            uint32_t red_mask = 0x00ff0000, green_mask = 0x0000ff00, blue_mask = 0x000000ff, alpha_mask = 0;
+            if (compression != 0)
+            {
+                const size_t masks = header >= 52 ? 14 + 40 : 14 + header;
+                const bool has_alpha = header >= 56 || compression == 6;
+                if (masks + (has_alpha ? 16 : 12) > size)
+                {
+                    std::cout << "truncated bmp" << std::endl;
+                    return false;
+                }
+
+                red_mask = le32(data + masks);
+                green_mask = le32(data + masks + 4);
+                blue_mask = le32(data + masks + 8);
+                alpha_mask = has_alpha ? le32(data + masks + 12) : 0;
+            }
+
+            if (!is_8_bit_mask(red_mask) || !is_8_bit_mask(green_mask) || !is_8_bit_mask(blue_mask) || !is_8_bit_mask(alpha_mask))
+            {
+                std::cout << "unsupported bmp channel masks" << std::endl;
+                return false;
+            }
+
+            const size_t row_bytes = ((size_t)width * bits + 31) / 32 * 4;
+            if (offset > size || row_bytes * (size_t)height > size - offset)
+            {
+                std::cout << "truncated bmp" << std::endl;
+                return false;
+            }
+
+            const cgi::type::alpha_mode_t alpha = alpha_mask ? cgi::type::alpha_mode_t::STRAIGHT : cgi::type::alpha_mode_t::NONE;
+            const unsigned char *pixels = data + offset;
+
+            const bool native = bits == 32 && red_mask == 0x00ff0000 && green_mask == 0x0000ff00 && blue_mask == 0x000000ff && (alpha_mask == 0 || alpha_mask == 0xff000000);
+            if (owner && native && top_down && offset % alignof(cgi::type::color_t) == 0)
+            {
+                image = cgi::type::image_t::wrap((cgi::type::color_t *)(data + offset), width, (int)height, width, cgi::type::pixel_format_t::BGRA, alpha, std::move(owner));
+                return true;
+            }
+
+            cgi::type::image_t decoded;
+            if (!allocate(decoded, width, (int)height, alpha))
+                return false;
+
+            const int rs = mask_shift(red_mask), gs = mask_shift(green_mask), bs = mask_shift(blue_mask), as = mask_shift(alpha_mask);
+
+            for (int y = 0; y < (int)height; y++)
+            {
+                const unsigned char *src = pixels + row_bytes * (size_t)(top_down ? y : height - 1 - y);
+                cgi::type::color_t *dst = decoded.row(y);
+
+                if (bits == 24)
+                {
+                    for (int x = 0; x < width; x++, src += 3)
+                        dst[x] = pack(src[2], src[1], src[0], 0);
+                }
+                else
+                {
+                    for (int x = 0; x < width; x++, src += 4)
+                    {
+                        const uint32_t p = le32(src);
+                        dst[x] = pack(channel(p, red_mask, rs), channel(p, green_mask, gs), channel(p, blue_mask, bs), channel(p, alpha_mask, as));
+                    }
+                }
+            }
+
+            image = std::move(decoded);
+            return true;
+        }
+
+        /// @brief decodes a binary netpbm image held in memory: P6 (rgb) or P5 (gray), any maxval up to 65535
+        /// @param data first byte of the file
+        /// @param size size of the file in bytes
+        /// @param image receives the pixels as an opaque COLORREF image
+        /// @return true if decoded
+        inline bool decode_ppm(const unsigned char *data, size_t size, cgi::type::image_t &image)
+        {
+            using namespace cgi::image_loader::detail;
+
+            if (size < 3 || data[0] != 'P' || (data[1] != '6' && data[1] != '5'))
+            {
+                std::cout << "not a binary ppm/pgm file" << std::endl;
+                return false;
+            }
+
+            const int channels = data[1] == '6' ? 3 : 1;
+
+            size_t at = 2;
+            uint32_t width = 0, height = 0, maxval = 0;
+            if (!pnm_number(data, size, at, width) || !pnm_number(data, size, at, height) || !pnm_number(data, size, at, maxval) || at >= size || !std::isspace(data[at]))
+            {
+                std::cout << "bad ppm header" << std::endl;
+                return false;
+            }
+            at++;
+
+            if (width == 0 || height == 0 || width > (1 << 16) || height > (1 << 16) || maxval == 0 || maxval > 65535)
+            {
+                std::cout << "unsupported ppm size or maxval" << std::endl;
+                return false;
+            }
+
+            const int sample_bytes = maxval > 255 ? 2 : 1;
+            const size_t row_bytes = (size_t)width * channels * sample_bytes;
+            if (row_bytes * height > size - at)
+            {
+                std::cout << "truncated ppm" << std::endl;
+                return false;
+            }
+
+            cgi::type::image_t decoded;
+            if (!allocate(decoded, (int)width, (int)height, cgi::type::alpha_mode_t::NONE))
+                return false;
+
+            // samples are rescaled to 0..255 unless the file already uses that range
+            uint8_t scale[256];
+            for (uint32_t v = 0; v < 256; v++)
+                scale[v] = (uint8_t)std::min<uint32_t>((v * 255 + maxval / 2) / maxval, 255);
+
+            for (uint32_t y = 0; y < height; y++)
+            {
+                const unsigned char *src = data + at + row_bytes * y;
+                cgi::type::color_t *dst = decoded.row((int)y);
+
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    uint32_t c[3];
+                    for (int k = 0; k < channels; k++, src += sample_bytes)
+                    {
+                        if (sample_bytes == 2)
+                            c[k] = std::min<uint32_t>((((uint32_t)src[0] << 8 | src[1]) * 255 + maxval / 2) / maxval, 255);
+                        else
+                            c[k] = maxval == 255 ? src[0] : scale[src[0]];
+                    }
+
+                    dst[x] = channels == 3 ? pack(c[0], c[1], c[2], 0) : pack(c[0], c[0], c[0], 0);
+                }
+            }
+
+            image = std::move(decoded);
+            return true;
+        }
+
+        /// @brief decodes a QOI image held in memory
+        /// @param data first byte of the file
+        /// @param size size of the file in bytes
+        /// @param image receives the pixels, COLORREF with straight alpha for 4 channel files and opaque for 3 channel ones
+        /// @return true if decoded
+        inline bool decode_qoi(const unsigned char *data, size_t size, cgi::type::image_t &image)
+        {
+            using namespace cgi::image_loader::detail;
+
+            if (size < 14 + 8 || std::memcmp(data, "qoif", 4) != 0)
+            {
+                std::cout << "not a qoi file" << std::endl;
+                return false;
+            }
+
+            const uint32_t width = be32(data + 4);
+            const uint32_t height = be32(data + 8);
+            const int channels = data[12];
+
+            if (width == 0 || height == 0 || width > (1 << 16) || height > (1 << 16) || (channels != 3 && channels != 4))
+            {
+                std::cout << "unsupported qoi size or channel count" << std::endl;
+                return false;
+            }
+
+            // one byte encodes at most a run of 62 pixels, so a header promising more than that is rejected before allocating
+            if ((unsigned long long)(size - 22) * 62 < (unsigned long long)width * height)
+            {
+                std::cout << "truncated qoi" << std::endl;
+                return false;
+            }
+
+            const cgi::type::alpha_mode_t alpha = channels == 4 ? cgi::type::alpha_mode_t::STRAIGHT : cgi::type::alpha_mode_t::NONE;
+            cgi::type::image_t decoded;
+            if (!allocate(decoded, (int)width, (int)height, alpha))
+                return false;
+
+            uint8_t index[64][4] = {};
+            uint8_t r = 0, g = 0, b = 0, a = 255;
+            const size_t end = size - 8;
+            size_t at = 14;
+            int run = 0;
+            size_t decoded_count = 0;
+
+            for (uint32_t y = 0; y < height; y++)
+            {
+                cgi::type::color_t *dst = decoded.row((int)y);
+
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    if (run > 0)
+                    {
+                        run--;
+                    }
+                    else
+                    {
+                        if (at >= end)
+                            break;
+
+                        const uint8_t op = data[at++];
+
+                        if (op == 0xfe)
+                        {
+                            if (at + 3 > end)
+                                break;
+                            r = data[at];
+                            g = data[at + 1];
+                            b = data[at + 2];
+                            at += 3;
+                        }
+                        else if (op == 0xff)
+                        {
+                            if (at + 4 > end)
+                                break;
+                            r = data[at];
+                            g = data[at + 1];
+                            b = data[at + 2];
+                            a = data[at + 3];
+                            at += 4;
+                        }
+                        else if ((op & 0xc0) == 0x00)
+                        {
+                            r = index[op][0];
+                            g = index[op][1];
+                            b = index[op][2];
+                            a = index[op][3];
+                        }
+                        else if ((op & 0xc0) == 0x40)
+                        {
+                            r += ((op >> 4) & 3) - 2;
+                            g += ((op >> 2) & 3) - 2;
+                            b += (op & 3) - 2;
+                        }
+                        else if ((op & 0xc0) == 0x80)
+                        {
+                            if (at >= end)
+                                break;
+                            const uint8_t next = data[at++];
+                            const int dg = (op & 0x3f) - 32;
+                            g += dg;
+                            r += dg - 8 + ((next >> 4) & 0x0f);
+                            b += dg - 8 + (next & 0x0f);
+                        }
+                        else
+                        {
+                            run = op & 0x3f;
+                        }
+
+                        uint8_t *slot = index[(r * 3 + g * 5 + b * 7 + a * 11) % 64];
+                        slot[0] = r;
+                        slot[1] = g;
+                        slot[2] = b;
+                        slot[3] = a;
+                    }
+
+                    dst[x] = pack(r, g, b, channels == 4 ? a : 0);
+                    decoded_count++;
+                }
+            }
+
+            if (decoded_count != (size_t)width * height)
+            {
+                std::cout << "truncated qoi" << std::endl;
+                return false;
+            }
+
+            image = std::move(decoded);
+            return true;
+        }
+
+        /// @brief loads a BMP file, see decode_bmp
+        /// @param path path of the file
+        /// @param image receives the pixels
+        /// @param zero_copy true to use a matching 32 bit file straight from the mapping (the image then keeps the file mapped)
+        /// @return true if loaded
+        inline bool load_bmp(const std::string &path, cgi::type::image_t &image, bool zero_copy = true)
+        {
+            auto file = std::make_shared<cgi::mapped_file>(path);
+            if (!file->is_open())
+                return false;
+
+            return decode_bmp(file->data(), file->size(), image, zero_copy ? file : nullptr);
+        }
+
+        /// @brief loads a binary PPM or PGM file, see decode_ppm
+        inline bool load_ppm(const std::string &path, cgi::type::image_t &image)
+        {
+            cgi::mapped_file file(path);
+            return file.is_open() && decode_ppm(file.data(), file.size(), image);
+        }
+
+        /// @brief loads a QOI file, see decode_qoi
+        inline bool load_qoi(const std::string &path, cgi::type::image_t &image)
+        {
+            cgi::mapped_file file(path);
+            return file.is_open() && decode_qoi(file.data(), file.size(), image);
+        }
+
+        /// @brief loads a BMP, PPM/PGM or QOI file, the format is told by the first bytes of the file
+        /// @param path path of the file
+        /// @param image receives the pixels
+        /// @param zero_copy true to let a matching BMP be used straight from the mapping
+        /// @return true if loaded
+        inline bool load(const std::string &path, cgi::type::image_t &image, bool zero_copy = true)
+        {
+            auto file = std::make_shared<cgi::mapped_file>(path);
+            if (!file->is_open())
+                return false;
+
+            const unsigned char *data = file->data();
+            const size_t size = file->size();
+
+            if (size >= 2 && data[0] == 'B' && data[1] == 'M')
+                return decode_bmp(file->data(), size, image, zero_copy ? file : nullptr);
+            if (size >= 2 && data[0] == 'P' && (data[1] == '6' || data[1] == '5'))
+                return decode_ppm(data, size, image);
+            if (size >= 4 && std::memcmp(data, "qoif", 4) == 0)
+                return decode_qoi(data, size, image);
+
+            std::cout << "unknown image format in file " << path << std::endl;
+            return false;
+        }
+    }
+}
+
+#endif
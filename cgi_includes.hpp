@@ -13,7 +13,12 @@
 
 
 
+#ifdef _WIN32
 #include "windows.h"
+#endif
+#include <cstdint>
+#include <array>
+#include <algorithm>
 #include <vector>
 #include <cmath>
 #include <iostream>
@@ -0,0 +1,199 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_INPUT_QUEUE_HPP
+#define CGI_INPUT_QUEUE_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+#include <atomic>
+#include <chrono>
+
+namespace cgi
+{
+    namespace type
+    {
+        /// @brief one recorded input event. which fields are used depends on kind:
+        /// KEY_DOWN / KEY_UP: code is the virtual key, repeat marks auto repeat. CHAR: code is the character.
+        /// MOUSE_MOVE: x, y. MOUSE_DOWN / MOUSE_UP: x, y and button. WHEEL: delta_x, delta_y in WM_MOUSEWHEEL units.
+        /// RESIZE: x, y are the new client width and height. FOCUS_LOST: nothing
+        struct input_event_t
+        {
+            cgi::type::input_kind_t kind = cgi::type::input_kind_t::KEY_DOWN;
+            long long time = 0;
+            int code = 0;
+            int x = 0;
+            int y = 0;
+            int delta_x = 0;
+            int delta_y = 0;
+            cgi::type::mouse_button_t button = cgi::type::mouse_button_t::LEFT;
+            bool repeat = false;
+        };
+    }
+
+    /// @brief fixed capacity ring for exactly one producer thread and one consumer thread, no locks and no allocation after construction. the indices live on separate cache lines so the two sides do not fight over them
+    /// @tparam T element type, copied in and out
+    /// @tparam N capacity, a power of two
+    template <typename T, size_t N>
+    class spsc_ring
+    {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "spsc_ring capacity must be a power of two");
+
+    private:
+        static constexpr size_t mask = N - 1;
+
+        T items[N];
+
+        // written by the producer only
+        alignas(64) std::atomic<size_t> tail{0};
+        size_t cached_head = 0;
+        unsigned long long dropped = 0;
+
+        // written by the consumer only
+        alignas(64) std::atomic<size_t> head{0};
+
+    public:
+        spsc_ring() = default;
+
+        spsc_ring(const spsc_ring &) = delete;
+        spsc_ring &operator=(const spsc_ring &) = delete;
+
+        /// @brief producer side. adds an item unless the ring is full
+        /// @param item item to copy in
+        /// @return false if the ring was full, the item is dropped and counted
+        bool push(const T &item) noexcept
+        {
+            const size_t t = this->tail.load(std::memory_order_relaxed);
+
+            // the consumer's index is only reloaded when the stale copy says the ring is full
+            if (t - this->cached_head == N)
+            {
+                this->cached_head = this->head.load(std::memory_order_acquire);
+                if (t - this->cached_head == N)
+                {
+                    this->dropped++;
+                    return false;
+                }
+            }
+
+            this->items[t & mask] = item;
+            this->tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief consumer side. takes the oldest item
+        /// @param out receives the item
+        /// @return false if the ring was empty
+        bool pop(T &out) noexcept
+        {
+            const size_t h = this->head.load(std::memory_order_relaxed);
+            if (h == this->tail.load(std::memory_order_acquire))
+                return false;
+
+            out = this->items[h & mask];
+            this->head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief consumer side. hands every item queued at the time of the call to a function, oldest first, and frees them in one step
+        /// @param fn called as fn(const T &) for each item
+        /// @return number of items handled
+        template <typename F>
+        size_t drain(F &&fn)
+        {
+            const size_t h = this->head.load(std::memory_order_relaxed);
+            const size_t t = this->tail.load(std::memory_order_acquire);
+
+            for (size_t i = h; i != t; i++)
+                fn((const T &)this->items[i & mask]);
+
+            this->head.store(t, std::memory_order_release);
+            return t - h;
+        }
+
+        /// @brief consumer side. copies up to max_count of the oldest items into an array
+        /// @param out array of at least max_count items
+        /// @param max_count most items to take
+        /// @return number of items copied
+        size_t drain(T *out, size_t max_count) noexcept
+        {
+            const size_t h = this->head.load(std::memory_order_relaxed);
+            const size_t t = this->tail.load(std::memory_order_acquire);
+            const size_t n = std::min(t - h, max_count);
+
+            for (size_t i = 0; i < n; i++)
+                out[i] = this->items[(h + i) & mask];
+
+            this->head.store(h + n, std::memory_order_release);
+            return n;
+        }
+
+        /// @brief consumer side. throws away everything queued
+        void clear() noexcept
+        {
+            this->head.store(this->tail.load(std::memory_order_acquire), std::memory_order_release);
+        }
+
+        /// @brief number of queued items, exact only on the consumer side
+        inline size_t size() const noexcept
+        {
+            return this->tail.load(std::memory_order_acquire) - this->head.load(std::memory_order_acquire);
+        }
+
+        inline bool empty() const noexcept
+        {
+            return this->size() == 0;
+        }
+
+        static constexpr size_t capacity() noexcept
+        {
+            return N;
+        }
+
+        /// @brief number of pushes refused because the ring was full, read it on the producer side
+        inline unsigned long long dropped_count() const noexcept
+        {
+            return this->dropped;
+        }
+    };
+
+    /// @brief input events of one window, pushed by the thread that handles its messages
+    class input_queue : public cgi::spsc_ring<cgi::type::input_event_t, 1024>
+    {
+    private:
+        std::atomic<bool> enabled{false};
+
+    public:
+        /// @brief turns recording on or off, off by default so a queue nobody drains does not fill up
+        inline void set_enabled(bool enable) noexcept
+        {
+            this->enabled.store(enable, std::memory_order_relaxed);
+        }
+
+        inline bool is_enabled() const noexcept
+        {
+            return this->enabled.load(std::memory_order_relaxed);
+        }
+
+        /// @brief stamps and queues an event if recording is on
+        /// @param e event to record, its time is set here
+        inline void record(cgi::type::input_event_t e) noexcept
+        {
+            if (!this->enabled.load(std::memory_order_relaxed))
+                return;
+
+            e.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            this->push(e);
+        }
+    };
+}
+
+#endif
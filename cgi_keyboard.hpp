@@ -0,0 +1,163 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_KEYBOARD_HPP
+#define CGI_KEYBOARD_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+#include <bitset>
+#include <string_view>
+
+namespace cgi
+{
+    /// @brief keyboard state fed by window messages. holds which of the 256 virtual keys are down plus the keys pressed and released since the frame began, so a key tapped between two frames still shows up as pressed and released. every query is a single bit test
+    class keyboard_state
+    {
+    public:
+        /// @brief number of virtual key codes
+        static constexpr int key_count = 256;
+
+        /// @brief most characters kept from WM_CHAR per frame, later ones are dropped
+        static constexpr int max_typed = 64;
+
+    private:
+        std::bitset<key_count> down;
+        std::bitset<key_count> pressed;
+        std::bitset<key_count> released;
+
+        char typed_chars[max_typed] = {};
+        int typed_count = 0;
+
+        /// @brief letters are reported by their upper case virtual key code
+        static inline int ascii_to_key(char key) noexcept
+        {
+            if (key >= 'a' && key <= 'z')
+                key = (char)(key - 32);
+            return (unsigned char)key;
+        }
+
+    public:
+        /// @brief records a WM_KEYDOWN / WM_SYSKEYDOWN
+        /// @param key virtual key code
+        /// @param repeat true for auto repeat messages, they do not count as a new press
+        inline void key_down(int key, bool repeat = false) noexcept
+        {
+            if (key < 0 || key >= key_count)
+                return;
+
+            if (!repeat || !this->down.test(key))
+                this->pressed.set(key);
+            this->down.set(key);
+        }
+
+        /// @brief records a WM_KEYUP / WM_SYSKEYUP
+        /// @param key virtual key code
+        inline void key_up(int key) noexcept
+        {
+            if (key < 0 || key >= key_count)
+                return;
+
+            this->down.reset(key);
+            this->released.set(key);
+        }
+
+        /// @brief records a WM_CHAR. characters outside 1 to 255 are ignored
+        /// @param ch character code
+        inline void key_char(unsigned int ch) noexcept
+        {
+            if (ch == 0 || ch > 255 || this->typed_count == max_typed)
+                return;
+
+            this->typed_chars[this->typed_count++] = (char)ch;
+        }
+
+        /// @brief releases every held key, e.g. when focus is lost and the key up messages go to another window
+        inline void release_all() noexcept
+        {
+            this->released |= this->down;
+            this->down.reset();
+        }
+
+        /// @brief starts a new frame, clears the pressed/released edges and the typed text
+        inline void begin_frame() noexcept
+        {
+            this->pressed.reset();
+            this->released.reset();
+            this->typed_count = 0;
+        }
+
+        /// @brief checks if a key is held
+        /// @param key virtual key code, e.g. VK_SPACE or 'A'
+        inline bool is_down(int key) const noexcept
+        {
+            return key >= 0 && key < key_count && this->down.test(key);
+        }
+
+        /// @brief checks if a key went down this frame
+        /// @param key virtual key code
+        inline bool was_pressed(int key) const noexcept
+        {
+            return key >= 0 && key < key_count && this->pressed.test(key);
+        }
+
+        /// @brief checks if a key went up this frame
+        /// @param key virtual key code
+        inline bool was_released(int key) const noexcept
+        {
+            return key >= 0 && key < key_count && this->released.test(key);
+        }
+
+        /// @brief checks if the key of an ASCII character is held, letters in either case map to the same key
+        /// @param key character from 32 to 126
+        inline bool is_ASCII_key_down(char key) const noexcept
+        {
+            return this->is_down(ascii_to_key(key));
+        }
+
+        /// @brief checks if the key of an ASCII character went down this frame
+        /// @param key character from 32 to 126
+        inline bool was_ASCII_key_pressed(char key) const noexcept
+        {
+            return this->was_pressed(ascii_to_key(key));
+        }
+
+        /// @brief checks if any key is held
+        inline bool any_down() const noexcept
+        {
+            return this->down.any();
+        }
+
+        /// @brief used to get the characters typed this frame in the order they arrived
+        /// @return view valid until the next frame begins
+        inline std::string_view typed() const noexcept
+        {
+            return std::string_view(this->typed_chars, (size_t)this->typed_count);
+        }
+
+        inline const std::bitset<key_count> &down_keys() const noexcept
+        {
+            return this->down;
+        }
+
+        inline const std::bitset<key_count> &pressed_keys() const noexcept
+        {
+            return this->pressed;
+        }
+
+        inline const std::bitset<key_count> &released_keys() const noexcept
+        {
+            return this->released;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,190 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_MASK_HPP
+#define CGI_MASK_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace cgi
+{
+    namespace type
+    {
+        using mask_word_t = std::uint64_t;
+
+        /// @brief packed 1 bit per pixel mask for stencils and glyphs. rows are contiguous 64 bit words in one allocation, pixel x of a row is bit (x % 64) of word (x / 64)
+        class mask_t
+        {
+        private:
+            int w = 0;
+            int h = 0;
+            int words = 0;
+            std::vector<cgi::type::mask_word_t> bits;
+
+        public:
+            mask_t() = default;
+
+            /// @brief creates a mask with every bit cleared
+            /// @param width width in pixels
+            /// @param height height in pixels
+            mask_t(int width, int height)
+            {
+                this->resize(width, height);
+            }
+
+            /// @brief converts an existing cgi::type::map2_t. '1' cells become set bits, anything else is cleared. width is the longest row
+            /// @param map map to convert
+            explicit mask_t(const cgi::type::map2_t &map)
+            {
+                int width = 0;
+                for (const cgi::type::map_t &line : map)
+                {
+                    width = std::max(width, (int)line.size());
+                }
+
+                this->resize(width, (int)map.size());
+
+                for (int y = 0; y < this->h; y++)
+                {
+                    for (int x = 0; x < (int)map[y].size(); x++)
+                    {
+                        if (map[y][x] == '1')
+                            this->set(x, y, true);
+                    }
+                }
+            }
+
+            /// @brief same as the map2_t constructor, reads better at call sites
+            /// @param map map to convert
+            /// @return the packed mask
+            static mask_t from_map2_t(const cgi::type::map2_t &map)
+            {
+                return mask_t(map);
+            }
+
+            /// @brief resizes the mask and clears every bit
+            /// @param width width in pixels
+            /// @param height height in pixels
+            void resize(int width, int height)
+            {
+                this->w = std::max(width, 0);
+                this->h = std::max(height, 0);
+                this->words = (this->w + 63) / 64;
+                this->bits.assign((size_t)this->words * this->h, 0);
+            }
+
+            inline int width() const noexcept
+            {
+                return this->w;
+            }
+
+            inline int height() const noexcept
+            {
+                return this->h;
+            }
+
+            /// @brief used to get the number of 64 bit words in one row
+            /// @return words per row
+            inline int words_per_row() const noexcept
+            {
+                return this->words;
+            }
+
+            /// @brief used to get the words of one row, no bounds check
+            /// @param y_pos row index
+            /// @return pointer to words_per_row() words
+            inline const cgi::type::mask_word_t *row(int y_pos) const noexcept
+            {
+                return this->bits.data() + (size_t)y_pos * this->words;
+            }
+
+            /// @brief mutable version of row()
+            /// @param y_pos row index
+            /// @return pointer to words_per_row() words
+            inline cgi::type::mask_word_t *row(int y_pos) noexcept
+            {
+                return this->bits.data() + (size_t)y_pos * this->words;
+            }
+
+            /// @brief reads one bit, false outside the mask
+            inline bool get(int x_pos, int y_pos) const noexcept
+            {
+                if (x_pos < 0 || x_pos >= this->w || y_pos < 0 || y_pos >= this->h)
+                    return false;
+                return (this->row(y_pos)[x_pos >> 6] >> (x_pos & 63)) & 1;
+            }
+
+            /// @brief writes one bit, ignored outside the mask
+            inline void set(int x_pos, int y_pos, bool value) noexcept
+            {
+                if (x_pos < 0 || x_pos >= this->w || y_pos < 0 || y_pos >= this->h)
+                    return;
+
+                cgi::type::mask_word_t &word = this->row(y_pos)[x_pos >> 6];
+                const cgi::type::mask_word_t bit = (cgi::type::mask_word_t)1 << (x_pos & 63);
+                word = value ? (word | bit) : (word & ~bit);
+            }
+
+            /// @brief sets or clears every bit inside the mask
+            /// @param value true to set every bit
+            void fill(bool value) noexcept
+            {
+                std::fill(this->bits.begin(), this->bits.end(), 0);
+
+                if (!value)
+                    return;
+
+                for (int y = 0; y < this->h; y++)
+                {
+                    for (int x = 0; x < this->w; x += 64)
+                    {
+                        const int n = std::min(64, this->w - x);
+                        this->row(y)[x >> 6] = n == 64 ? ~(cgi::type::mask_word_t)0 : (((cgi::type::mask_word_t)1 << n) - 1);
+                    }
+                }
+            }
+
+            /// @brief used to get the memory held by the bits
+            /// @return size in bytes
+            inline size_t byte_size() const noexcept
+            {
+                return this->bits.size() * sizeof(cgi::type::mask_word_t);
+            }
+
+            /// @brief index of the lowest set bit, word must not be 0
+            static inline int lowest_bit(cgi::type::mask_word_t word) noexcept
+            {
+#if defined(__GNUC__) || defined(__clang__)
+                return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+                unsigned long index;
+                _BitScanForward64(&index, word);
+                return (int)index;
+#else
+                int index = 0;
+                while (!(word & 1))
+                {
+                    word >>= 1;
+                    index++;
+                }
+                return index;
+#endif
+            }
+        };
+    }
+}
+
+#endif
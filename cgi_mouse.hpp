@@ -0,0 +1,190 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_MOUSE_HPP
+#define CGI_MOUSE_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+
+namespace cgi
+{
+    /// @brief mouse state fed by window messages, in client coordinates. any number of move messages in a frame collapse into the latest position plus the summed motion, so a 1000 Hz mouse costs no more to read than a 125 Hz one. reads are plain loads
+    class mouse_state
+    {
+    public:
+        /// @brief one wheel notch in the units of WM_MOUSEWHEEL
+        static constexpr int wheel_notch = 120;
+
+    private:
+        int x = 0;
+        int y = 0;
+        int delta_x = 0;
+        int delta_y = 0;
+        int moves = 0;
+        bool inside = false;
+
+        int wheel_x = 0;
+        int wheel_y = 0;
+
+        unsigned int down = 0;
+        unsigned int pressed = 0;
+        unsigned int released = 0;
+
+        static inline unsigned int bit(cgi::type::mouse_button_t button) noexcept
+        {
+            return 1u << (unsigned int)button;
+        }
+
+    public:
+        /// @brief records a WM_MOUSEMOVE
+        /// @param x_pos cursor x in client coordinates
+        /// @param y_pos cursor y in client coordinates
+        inline void move(int x_pos, int y_pos) noexcept
+        {
+            // the first position after entering has nothing to be relative to
+            if (this->inside)
+            {
+                this->delta_x += x_pos - this->x;
+                this->delta_y += y_pos - this->y;
+            }
+
+            this->x = x_pos;
+            this->y = y_pos;
+            this->inside = true;
+            this->moves++;
+        }
+
+        /// @brief records a WM_MOUSELEAVE, the last position is kept
+        inline void leave() noexcept
+        {
+            this->inside = false;
+        }
+
+        /// @brief records a button down message
+        inline void button_down(cgi::type::mouse_button_t button) noexcept
+        {
+            this->down |= bit(button);
+            this->pressed |= bit(button);
+        }
+
+        /// @brief records a button up message
+        inline void button_up(cgi::type::mouse_button_t button) noexcept
+        {
+            this->down &= ~bit(button);
+            this->released |= bit(button);
+        }
+
+        /// @brief releases every held button, e.g. when mouse capture is lost
+        inline void release_all() noexcept
+        {
+            this->released |= this->down;
+            this->down = 0;
+        }
+
+        /// @brief records a wheel message, deltas of one frame add up
+        /// @param horizontal WM_MOUSEHWHEEL delta
+        /// @param vertical WM_MOUSEWHEEL delta
+        inline void wheel(int horizontal, int vertical) noexcept
+        {
+            this->wheel_x += horizontal;
+            this->wheel_y += vertical;
+        }
+
+        /// @brief starts a new frame, clears motion, wheel and button edges
+        inline void begin_frame() noexcept
+        {
+            this->delta_x = 0;
+            this->delta_y = 0;
+            this->moves = 0;
+            this->wheel_x = 0;
+            this->wheel_y = 0;
+            this->pressed = 0;
+            this->released = 0;
+        }
+
+        /// @brief used to get the latest cursor x in client coordinates
+        inline int get_x() const noexcept
+        {
+            return this->x;
+        }
+
+        /// @brief used to get the latest cursor y in client coordinates
+        inline int get_y() const noexcept
+        {
+            return this->y;
+        }
+
+        /// @brief used to get the horizontal motion this frame
+        inline int get_dx() const noexcept
+        {
+            return this->delta_x;
+        }
+
+        /// @brief used to get the vertical motion this frame
+        inline int get_dy() const noexcept
+        {
+            return this->delta_y;
+        }
+
+        /// @brief number of move messages collapsed into this frame
+        inline int move_count() const noexcept
+        {
+            return this->moves;
+        }
+
+        /// @brief checks if the cursor is over the client area (or captured by a held button)
+        inline bool is_inside() const noexcept
+        {
+            return this->inside;
+        }
+
+        /// @brief used to get the summed horizontal wheel delta this frame
+        /// @return delta in WM_MOUSEHWHEEL units, wheel_notch per notch
+        inline int get_wheel_x() const noexcept
+        {
+            return this->wheel_x;
+        }
+
+        /// @brief used to get the summed vertical wheel delta this frame
+        /// @return delta in WM_MOUSEWHEEL units, wheel_notch per notch
+        inline int get_wheel_y() const noexcept
+        {
+            return this->wheel_y;
+        }
+
+        /// @brief checks if a button is held
+        inline bool is_down(cgi::type::mouse_button_t button) const noexcept
+        {
+            return this->down & bit(button);
+        }
+
+        /// @brief checks if a button went down this frame
+        inline bool was_pressed(cgi::type::mouse_button_t button) const noexcept
+        {
+            return this->pressed & bit(button);
+        }
+
+        /// @brief checks if a button went up this frame
+        inline bool was_released(cgi::type::mouse_button_t button) const noexcept
+        {
+            return this->released & bit(button);
+        }
+
+        /// @brief checks if any button is held
+        inline bool any_down() const noexcept
+        {
+            return this->down != 0;
+        }
+    };
+}
+
+#endif
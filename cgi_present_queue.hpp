@@ -0,0 +1,231 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_PRESENT_QUEUE_HPP
+#define CGI_PRESENT_QUEUE_HPP
+
+#pragma once
+
+#include "cgi_dirty.hpp"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace cgi
+{
+    /// @brief hands finished frames to a present thread so the next frame can be drawn while the last one is shown. submit() copies only the damaged rectangles of a frame into a free slot and returns, the present thread shows the slots in order. at most latency frames are waiting or being shown, submit() blocks when they are all taken, so the delay between drawing and showing a frame is bounded. one thread submits, one thread presents
+    class present_queue
+    {
+    public:
+        /// @brief most frames that may be in flight
+        static constexpr int max_latency = 3;
+
+        /// @brief one submitted frame. only the damaged rectangles of pixels are valid
+        struct frame
+        {
+            cgi::type::buf_color_t pixels;
+            int width = 0;
+            int height = 0;
+            cgi::dirty_region damage;
+            unsigned long long index = 0;
+        };
+
+        using present_fn = std::function<void(const frame &)>;
+
+    private:
+        frame slots[max_latency];
+        int latency = 0;
+        int head = 0;
+        int queued = 0;
+
+        std::mutex lock;
+        std::condition_variable ready;
+        std::condition_variable released;
+        std::thread worker;
+        bool stopping = false;
+
+        present_fn present;
+        unsigned long long submitted = 0;
+        unsigned long long presented = 0;
+
+        void worker_loop()
+        {
+            std::unique_lock<std::mutex> guard(this->lock);
+
+            for (;;)
+            {
+                this->ready.wait(guard, [&]
+                                 { return this->stopping || this->queued > 0; });
+
+                if (this->stopping)
+                    return;
+
+                const frame &next = this->slots[this->head];
+                guard.unlock();
+
+                // the slot at head is never written by submit() while it is counted as queued
+                this->present(next);
+
+                guard.lock();
+                this->head = (this->head + 1) % this->latency;
+                this->queued--;
+                this->presented++;
+                this->released.notify_all();
+            }
+        }
+
+    public:
+        present_queue() = default;
+
+        present_queue(const present_queue &) = delete;
+        present_queue &operator=(const present_queue &) = delete;
+
+        ~present_queue()
+        {
+            this->stop();
+        }
+
+        /// @brief starts the present thread, stopping a running one first
+        /// @param frames_in_flight frames that may be submitted but not yet shown, 1 is double buffering and 2 triple buffering (1 to max_latency)
+        /// @param present_function called on the present thread for every frame, in submit order
+        /// @return true if the thread started
+        bool start(int frames_in_flight, present_fn present_function)
+        {
+            this->stop();
+
+            this->latency = std::min(std::max(frames_in_flight, 1), max_latency);
+            this->present = std::move(present_function);
+            this->head = 0;
+            this->queued = 0;
+            this->stopping = false;
+
+            try
+            {
+                this->worker = std::thread(&cgi::present_queue::worker_loop, this);
+                return true;
+            }
+            catch (...)
+            {
+                std::cout << "could not start the present thread" << std::endl;
+                this->latency = 0;
+                return false;
+            }
+        }
+
+        /// @brief stops the present thread. frames not yet shown are dropped
+        void stop()
+        {
+            if (!this->worker.joinable())
+                return;
+
+            {
+                std::lock_guard<std::mutex> guard(this->lock);
+                this->stopping = true;
+            }
+            this->ready.notify_all();
+            this->worker.join();
+
+            this->queued = 0;
+            this->latency = 0;
+            for (frame &f : this->slots)
+            {
+                f.pixels = cgi::type::buf_color_t();
+                f.width = f.height = 0;
+            }
+        }
+
+        /// @brief checks if the present thread is running
+        inline bool running() const noexcept
+        {
+            return this->latency > 0;
+        }
+
+        /// @brief used to get the configured number of frames in flight
+        inline int get_latency() const noexcept
+        {
+            return this->latency;
+        }
+
+        /// @brief copies the damaged rectangles of a frame into a free slot and queues it. blocks while every slot is taken
+        /// @param pixels first pixel of the frame
+        /// @param width width of the frame in pixels
+        /// @param height height of the frame in pixels
+        /// @param stride distance between rows in pixels
+        /// @param damage rectangles that changed since the last submitted frame
+        /// @return false if the queue is not running
+        bool submit(const cgi::type::color_t *pixels, int width, int height, int stride, const cgi::dirty_region &damage)
+        {
+            if (this->latency == 0)
+                return false;
+
+            std::unique_lock<std::mutex> guard(this->lock);
+            this->released.wait(guard, [&]
+                                { return this->stopping || this->queued < this->latency; });
+
+            if (this->stopping)
+                return false;
+
+            frame &slot = this->slots[(this->head + this->queued) % this->latency];
+            guard.unlock();
+
+            if (slot.width != width || slot.height != height)
+            {
+                slot.pixels.assign((size_t)width * height, 0);
+                slot.width = width;
+                slot.height = height;
+            }
+
+            slot.damage = damage;
+            slot.index = this->submitted;
+
+            for (int i = 0; i < damage.size(); i++)
+            {
+                const cgi::type::rect_t r = damage.at(i);
+                for (int y = r.y; y < r.y + r.height; y++)
+                {
+                    const cgi::type::color_t *src = pixels + (size_t)y * stride + r.x;
+                    std::copy(src, src + r.width, slot.pixels.data() + (size_t)y * width + r.x);
+                }
+            }
+
+            guard.lock();
+            this->queued++;
+            this->submitted++;
+            this->ready.notify_one();
+
+            return true;
+        }
+
+        /// @brief waits until every submitted frame has been shown
+        void drain()
+        {
+            std::unique_lock<std::mutex> guard(this->lock);
+            this->released.wait(guard, [&]
+                                { return this->stopping || this->queued == 0; });
+        }
+
+        /// @brief used to get the number of frames waiting or being shown
+        inline int in_flight() noexcept
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            return this->queued;
+        }
+
+        /// @brief number of frames shown since start
+        inline unsigned long long presented_count() noexcept
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            return this->presented;
+        }
+    };
+}
+
+#endif
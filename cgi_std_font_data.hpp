@@ -0,0 +1,138 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_STD_FONT_DATA_HPP
+#define CGI_STD_FONT_DATA_HPP
+
+#pragma once
+
+#include <cstdint>
+
+namespace cgi
+{
+    namespace font_data
+    {
+        /// @brief rows a glyph of an embedded font can have
+        constexpr int max_rows = 8;
+
+        /// @brief one glyph of an embedded font. each row reads like the font file, the most significant of the width bits is the leftmost column
+        struct glyph
+        {
+            unsigned char code;
+            unsigned char width;
+            unsigned char height;
+            std::uint8_t rows[max_rows];
+        };
+
+        /// @brief font.txt compiled in, so the default font needs no file and no parsing. generated by gen_font_data.py, edit font.txt and rerun it instead of editing this table
+        constexpr cgi::font_data::glyph standard[] = {
+            {' ', 6, 7, {0b000000, 0b000000, 0b000000, 0b000000, 0b000000, 0b000000, 0b000000}},
+            {'!', 6, 7, {0b001000, 0b001000, 0b001000, 0b001000, 0b000000, 0b001000, 0b000000}},
+            {'"', 6, 7, {0b010100, 0b010100, 0b010100, 0b000000, 0b000000, 0b000000, 0b000000}},
+            {'#', 6, 7, {0b010100, 0b010100, 0b111110, 0b010100, 0b111110, 0b010100, 0b010100}},
+            {'$', 6, 7, {0b001000, 0b011110, 0b101000, 0b011100, 0b001010, 0b111100, 0b001000}},
+            {'%', 6, 7, {0b110000, 0b110010, 0b000100, 0b001000, 0b010000, 0b100110, 0b000110}},
+            {'&', 6, 7, {0b011000, 0b100100, 0b101000, 0b010000, 0b101010, 0b100100, 0b011010}},
+            {'\'', 6, 7, {0b001000, 0b001000, 0b001000, 0b000000, 0b000000, 0b000000, 0b000000}},
+            {'(', 6, 7, {0b000100, 0b001000, 0b010000, 0b010000, 0b010000, 0b001000, 0b000100}},
+            {')', 6, 7, {0b010000, 0b001000, 0b000100, 0b000100, 0b000100, 0b001000, 0b010000}},
+            {'*', 6, 7, {0b000000, 0b010100, 0b001000, 0b111110, 0b001000, 0b010100, 0b000000}},
+            {'+', 6, 7, {0b000000, 0b001000, 0b001000, 0b111110, 0b001000, 0b001000, 0b000000}},
+            {',', 6, 7, {0b000000, 0b000000, 0b000000, 0b000000, 0b001000, 0b001000, 0b010000}},
+            {'-', 6, 7, {0b000000, 0b000000, 0b000000, 0b111110, 0b000000, 0b000000, 0b000000}},
+            {'.', 6, 7, {0b000000, 0b000000, 0b000000, 0b000000, 0b000000, 0b001000, 0b000000}},
+            {'/', 6, 7, {0b000010, 0b000100, 0b001000, 0b010000, 0b100000, 0b000000, 0b000000}},
+            {'0', 6, 7, {0b011100, 0b100010, 0b100110, 0b101010, 0b110010, 0b100010, 0b011100}},
+            {'1', 6, 7, {0b001000, 0b011000, 0b001000, 0b001000, 0b001000, 0b001000, 0b011100}},
+            {'2', 6, 7, {0b011100, 0b100010, 0b000010, 0b001100, 0b010000, 0b100000, 0b111110}},
+            {'3', 6, 7, {0b011100, 0b100010, 0b000010, 0b001100, 0b000010, 0b100010, 0b011100}},
+            {'4', 6, 7, {0b000100, 0b001100, 0b010100, 0b100100, 0b111110, 0b000100, 0b000100}},
+            {'5', 6, 7, {0b111110, 0b100000, 0b111100, 0b000010, 0b000010, 0b100010, 0b011100}},
+            {'6', 6, 7, {0b001100, 0b010000, 0b100000, 0b111100, 0b100010, 0b100010, 0b011100}},
+            {'7', 6, 7, {0b111110, 0b000010, 0b000100, 0b001000, 0b010000, 0b010000, 0b010000}},
+            {'8', 6, 7, {0b011100, 0b100010, 0b100010, 0b011100, 0b100010, 0b100010, 0b011100}},
+            {'9', 6, 7, {0b011100, 0b100010, 0b100010, 0b011110, 0b000010, 0b000100, 0b011000}},
+            {':', 6, 7, {0b000000, 0b001000, 0b000000, 0b000000, 0b000000, 0b001000, 0b000000}},
+            {';', 6, 7, {0b000000, 0b001000, 0b000000, 0b000000, 0b001000, 0b001000, 0b010000}},
+            {'<', 6, 7, {0b000100, 0b001000, 0b010000, 0b100000, 0b010000, 0b001000, 0b000100}},
+            {'=', 6, 7, {0b000000, 0b111110, 0b000000, 0b111110, 0b000000, 0b000000, 0b000000}},
+            {'>', 6, 7, {0b010000, 0b001000, 0b000100, 0b000010, 0b000100, 0b001000, 0b010000}},
+            {'?', 6, 7, {0b011100, 0b100010, 0b000010, 0b001100, 0b001000, 0b000000, 0b001000}},
+            {'@', 6, 7, {0b011100, 0b100010, 0b101110, 0b101010, 0b101110, 0b100000, 0b011100}},
+            {'A', 6, 7, {0b001000, 0b010100, 0b100010, 0b111110, 0b100010, 0b100010, 0b100010}},
+            {'B', 6, 7, {0b111100, 0b100010, 0b100010, 0b111100, 0b100010, 0b100010, 0b111100}},
+            {'C', 6, 7, {0b011100, 0b100010, 0b100000, 0b100000, 0b100000, 0b100010, 0b011100}},
+            {'D', 6, 7, {0b111000, 0b100100, 0b100010, 0b100010, 0b100010, 0b100100, 0b111000}},
+            {'E', 6, 7, {0b111110, 0b100000, 0b100000, 0b111100, 0b100000, 0b100000, 0b111110}},
+            {'F', 6, 7, {0b111110, 0b100000, 0b100000, 0b111100, 0b100000, 0b100000, 0b100000}},
+            {'G', 6, 7, {0b011100, 0b100010, 0b100000, 0b101110, 0b100010, 0b100010, 0b011100}},
+            {'H', 6, 7, {0b100010, 0b100010, 0b100010, 0b111110, 0b100010, 0b100010, 0b100010}},
+            {'I', 6, 7, {0b011100, 0b001000, 0b001000, 0b001000, 0b001000, 0b001000, 0b011100}},
+            {'J', 6, 7, {0b000010, 0b000010, 0b000010, 0b000010, 0b000010, 0b100010, 0b011100}},
+            {'K', 6, 7, {0b100010, 0b100100, 0b101000, 0b110000, 0b101000, 0b100100, 0b100010}},
+            {'L', 6, 7, {0b100000, 0b100000, 0b100000, 0b100000, 0b100000, 0b100000, 0b111110}},
+            {'M', 6, 7, {0b100010, 0b110110, 0b101010, 0b101010, 0b100010, 0b100010, 0b100010}},
+            {'N', 6, 7, {0b100010, 0b100010, 0b110010, 0b101010, 0b100110, 0b100010, 0b100010}},
+            {'O', 6, 7, {0b011100, 0b100010, 0b100010, 0b100010, 0b100010, 0b100010, 0b011100}},
+            {'P', 6, 7, {0b111100, 0b100010, 0b100010, 0b111100, 0b100000, 0b100000, 0b100000}},
+            {'Q', 6, 7, {0b011100, 0b100010, 0b100010, 0b100010, 0b101010, 0b100100, 0b011010}},
+            {'R', 6, 7, {0b111100, 0b100010, 0b100010, 0b111100, 0b101000, 0b100100, 0b100010}},
+            {'S', 6, 7, {0b011110, 0b100000, 0b100000, 0b011100, 0b000010, 0b000010, 0b111100}},
+            {'T', 6, 7, {0b111110, 0b001000, 0b001000, 0b001000, 0b001000, 0b001000, 0b001000}},
+            {'U', 6, 7, {0b100010, 0b100010, 0b100010, 0b100010, 0b100010, 0b100010, 0b011100}},
+            {'V', 6, 7, {0b100010, 0b100010, 0b100010, 0b100010, 0b100010, 0b010100, 0b001000}},
+            {'W', 6, 7, {0b100010, 0b100010, 0b100010, 0b101010, 0b101010, 0b110110, 0b100010}},
+            {'X', 6, 7, {0b100010, 0b100010, 0b010100, 0b001000, 0b010100, 0b100010, 0b100010}},
+            {'Y', 6, 7, {0b100010, 0b100010, 0b010100, 0b001000, 0b001000, 0b001000, 0b001000}},
+            {'Z', 6, 7, {0b111110, 0b000010, 0b000100, 0b001000, 0b010000, 0b100000, 0b111110}},
+            {'[', 6, 7, {0b011100, 0b010000, 0b010000, 0b010000, 0b010000, 0b010000, 0b011100}},
+            {'\\', 6, 7, {0b100000, 0b010000, 0b001000, 0b000100, 0b000010, 0b000000, 0b000000}},
+            {']', 6, 7, {0b011100, 0b000010, 0b000010, 0b000010, 0b000010, 0b000010, 0b011100}},
+            {'^', 6, 7, {0b001000, 0b010100, 0b100010, 0b000000, 0b000000, 0b000000, 0b000000}},
+            {'_', 6, 7, {0b000000, 0b000000, 0b000000, 0b000000, 0b000000, 0b000000, 0b111110}},
+            {'`', 6, 7, {0b001000, 0b001000, 0b000100, 0b000000, 0b000000, 0b000000, 0b000000}},
+            {'a', 6, 7, {0b000000, 0b000000, 0b011100, 0b000010, 0b011110, 0b100010, 0b011110}},
+            {'b', 6, 7, {0b100000, 0b100000, 0b101100, 0b110010, 0b100010, 0b100010, 0b111100}},
+            {'c', 6, 7, {0b000000, 0b000000, 0b011100, 0b100000, 0b100000, 0b100000, 0b011100}},
+            {'d', 6, 7, {0b000010, 0b000010, 0b011010, 0b100110, 0b100010, 0b100010, 0b011110}},
+            {'e', 6, 7, {0b000000, 0b000000, 0b011100, 0b100010, 0b111110, 0b100000, 0b011100}},
+            {'f', 6, 7, {0b001100, 0b010000, 0b111000, 0b010000, 0b010000, 0b010000, 0b010000}},
+            {'g', 6, 8, {0b000000, 0b000000, 0b011110, 0b100010, 0b100010, 0b011110, 0b000010, 0b011100}},
+            {'h', 6, 7, {0b100000, 0b100000, 0b101100, 0b110010, 0b100010, 0b100010, 0b100010}},
+            {'i', 6, 7, {0b001000, 0b000000, 0b011000, 0b001000, 0b001000, 0b001000, 0b011100}},
+            {'j', 6, 8, {0b000100, 0b000000, 0b001100, 0b000100, 0b000100, 0b000100, 0b000100, 0b011000}},
+            {'k', 6, 7, {0b100000, 0b100000, 0b100100, 0b101000, 0b110000, 0b101000, 0b100100}},
+            {'l', 6, 7, {0b011000, 0b001000, 0b001000, 0b001000, 0b001000, 0b001000, 0b011100}},
+            {'m', 6, 7, {0b000000, 0b000000, 0b110100, 0b101010, 0b101010, 0b100010, 0b100010}},
+            {'n', 6, 7, {0b000000, 0b000000, 0b101100, 0b110010, 0b100010, 0b100010, 0b100010}},
+            {'o', 6, 7, {0b000000, 0b000000, 0b011100, 0b100010, 0b100010, 0b100010, 0b011100}},
+            {'p', 6, 8, {0b000000, 0b000000, 0b111100, 0b100010, 0b100010, 0b111100, 0b100000, 0b100000}},
+            {'q', 6, 8, {0b000000, 0b000000, 0b011110, 0b100010, 0b100010, 0b011110, 0b000010, 0b000010}},
+            {'r', 6, 7, {0b000000, 0b000000, 0b101100, 0b110010, 0b100000, 0b100000, 0b100000}},
+            {'s', 6, 7, {0b000000, 0b000000, 0b011110, 0b100000, 0b011100, 0b000010, 0b111100}},
+            {'t', 6, 7, {0b010000, 0b010000, 0b111000, 0b010000, 0b010000, 0b010000, 0b001100}},
+            {'u', 6, 7, {0b000000, 0b000000, 0b100010, 0b100010, 0b100010, 0b100110, 0b011010}},
+            {'v', 6, 7, {0b000000, 0b000000, 0b100010, 0b100010, 0b100010, 0b010100, 0b001000}},
+            {'w', 6, 7, {0b000000, 0b000000, 0b100010, 0b100010, 0b101010, 0b101010, 0b010100}},
+            {'x', 6, 7, {0b000000, 0b000000, 0b100010, 0b010100, 0b001000, 0b010100, 0b100010}},
+            {'y', 6, 8, {0b000000, 0b000000, 0b100010, 0b100010, 0b100010, 0b011110, 0b000010, 0b011100}},
+            {'z', 6, 7, {0b000000, 0b000000, 0b111110, 0b000100, 0b001000, 0b010000, 0b111110}},
+            {'{', 6, 7, {0b000100, 0b001000, 0b001000, 0b010000, 0b001000, 0b001000, 0b000100}},
+            {'|', 6, 7, {0b001000, 0b001000, 0b001000, 0b001000, 0b001000, 0b001000, 0b001000}},
+            {'}', 6, 7, {0b010000, 0b001000, 0b001000, 0b000100, 0b001000, 0b001000, 0b010000}},
+            {'~', 6, 7, {0b010000, 0b101010, 0b000100, 0b000000, 0b000000, 0b000000, 0b000000}},
+        };
+
+        /// @brief number of glyphs in the standard table
+        constexpr int standard_count = (int)(sizeof(cgi::font_data::standard) / sizeof(cgi::font_data::standard[0]));
+    }
+}
+
+#endif
@@ -14,11 +14,319 @@
 
 #pragma once
 
+#include "cgi_data_types.hpp"
+#include "cgi_mask.hpp"
+#include "cgi_std_font_data.hpp"
+#include <sstream>
+#include <string>
+#include <string_view>
 
-//fix font loader
+namespace cgi
+{
+    namespace type
+    {
+        /// @brief where a glyph sits in the font atlas and how far it moves the pen
+        struct glyph_t
+        {
+            int x = 0;
+            int width = 0;
+            int height = 0;
+            int advance = 0;
+            bool present = false;
+        };
 
-// #include "cgi_includes.hpp"
-#include "cgi_data_types.hpp"
+        /// @brief bitmap font parsed once into a packed 1 bit atlas. every glyph is a column range of the atlas rows, so drawing text reads bits straight out of it without building anything per string
+        class font_t
+        {
+        public:
+            /// @brief widest glyph supported, one glyph row must fit in a mask word
+            static constexpr int max_glyph_width = 64;
+
+        private:
+            cgi::type::mask_t atlas;
+            std::array<cgi::type::glyph_t, 256> glyphs{};
+            int line_height = 0;
+
+        public:
+            font_t() = default;
+
+            /// @brief loads a font file, see parse() for the format
+            /// @param path path of the font file, e.g. "font.txt"
+            explicit font_t(const std::string &path)
+            {
+                this->load(path);
+            }
+
+            /// @brief the built in font, font.txt compiled into cgi_std_font_data.hpp. built on first use without touching the disk
+            /// @return reference to the shared font
+            static const font_t &standard()
+            {
+                static const font_t font = []
+                {
+                    font_t f;
+                    f.load_table(cgi::font_data::standard, cgi::font_data::standard_count);
+                    return f;
+                }();
+                return font;
+            }
+
+            /// @brief loads a compiled in glyph table, no parsing involved
+            /// @param table first glyph of the table
+            /// @param count number of glyphs
+            /// @return true if the table held at least one glyph
+            bool load_table(const cgi::font_data::glyph *table, int count)
+            {
+                if (!table || count <= 0)
+                {
+                    std::cout << "font has no glyphs" << std::endl;
+                    return false;
+                }
+
+                int atlas_width = 0;
+                int atlas_height = 0;
+                for (int i = 0; i < count; i++)
+                {
+                    atlas_width += table[i].width;
+                    atlas_height = std::max(atlas_height, (int)table[i].height);
+                }
+
+                this->atlas.resize(atlas_width, atlas_height);
+                this->glyphs = {};
+                this->line_height = atlas_height;
+
+                int x = 0;
+                for (int i = 0; i < count; i++)
+                {
+                    const cgi::font_data::glyph &entry = table[i];
+                    cgi::type::glyph_t &g = this->glyphs[entry.code];
+                    g.x = x;
+                    g.width = entry.width;
+                    g.height = std::min((int)entry.height, cgi::font_data::max_rows);
+                    g.advance = entry.width;
+                    g.present = true;
+
+                    for (int r = 0; r < g.height; r++)
+                    {
+                        for (int c = 0; c < g.width; c++)
+                        {
+                            if ((entry.rows[r] >> (g.width - 1 - c)) & 1)
+                                this->atlas.set(x + c, r, true);
+                        }
+                    }
+
+                    x += g.width;
+                }
+
+                return true;
+            }
+
+            /// @brief loads a font file, see parse() for the format
+            /// @param path path of the font file, e.g. "font.txt"
+            /// @return true if the file was read and held at least one glyph
+            bool load(const std::string &path)
+            {
+                std::ifstream file(path);
+                if (!file)
+                {
+                    std::cout << "could not open font file " << path << std::endl;
+                    return false;
+                }
+
+                return this->parse(file);
+            }
+
+            /// @brief parses glyph blocks. each block starts with a header line "~CHAR: <code> '<char>'" followed by one line of '0'/'1' per glyph row, up to the next header or blank line. the width of a glyph is its longest row
+            /// @param in stream to read from
+            /// @return true if at least one glyph was read, the font is left unchanged otherwise
+            bool parse(std::istream &in)
+            {
+                struct block
+                {
+                    int code;
+                    std::vector<std::string> rows;
+                };
+
+                std::vector<block> blocks;
+                std::string line;
+                bool in_block = false;
+
+                while (std::getline(in, line))
+                {
+                    if (!line.empty() && line.back() == '\r')
+                        line.pop_back();
+
+                    if (line.rfind("~CHAR:", 0) == 0)
+                    {
+                        std::istringstream header(line.substr(6));
+                        int code = -1;
+                        header >> code;
+
+                        in_block = code >= 0 && code < 256;
+                        if (in_block)
+                            blocks.push_back({code, {}});
+                        else
+                            std::cout << "skipping glyph with unsupported code in line: " << line << std::endl;
+                        continue;
+                    }
+
+                    if (line.empty())
+                    {
+                        in_block = false;
+                        continue;
+                    }
+
+                    if (in_block)
+                        blocks.back().rows.push_back(line);
+                }
+
+                int atlas_width = 0;
+                int atlas_height = 0;
+                for (const block &b : blocks)
+                {
+                    int width = 0;
+                    for (const std::string &row : b.rows)
+                        width = std::max(width, (int)row.size());
+
+                    if (width > max_glyph_width)
+                    {
+                        std::cout << "glyph " << b.code << " is wider than " << max_glyph_width << " pixels" << std::endl;
+                        return false;
+                    }
+
+                    atlas_width += width;
+                    atlas_height = std::max(atlas_height, (int)b.rows.size());
+                }
+
+                if (blocks.empty())
+                {
+                    std::cout << "font has no glyphs" << std::endl;
+                    return false;
+                }
+
+                this->atlas.resize(atlas_width, atlas_height);
+                this->glyphs = {};
+                this->line_height = atlas_height;
+
+                int x = 0;
+                for (const block &b : blocks)
+                {
+                    cgi::type::glyph_t &g = this->glyphs[b.code];
+                    g.x = x;
+                    g.width = 0;
+                    g.height = (int)b.rows.size();
+                    g.present = true;
+
+                    for (int r = 0; r < g.height; r++)
+                    {
+                        const std::string &row = b.rows[r];
+                        g.width = std::max(g.width, (int)row.size());
+
+                        for (int c = 0; c < (int)row.size(); c++)
+                        {
+                            if (row[c] == '1')
+                                this->atlas.set(x + c, r, true);
+                        }
+                    }
+
+                    g.advance = g.width;
+                    x += g.width;
+                }
+
+                return true;
+            }
+
+            /// @brief checks if no font has been loaded
+            inline bool empty() const noexcept
+            {
+                return this->line_height == 0;
+            }
+
+            /// @brief used to get the height of one line of text before scaling
+            /// @return height in pixels
+            inline int height() const noexcept
+            {
+                return this->line_height;
+            }
+
+            /// @brief used to get the packed atlas, glyphs side by side in one row of cells
+            inline const cgi::type::mask_t &get_atlas() const noexcept
+            {
+                return this->atlas;
+            }
+
+            /// @brief used to get the metrics of a character. characters missing from the font fall back to '?'
+            /// @param ch character to look up
+            /// @return the glyph or nullptr if neither it nor '?' is in the font
+            inline const cgi::type::glyph_t *glyph(char ch) const noexcept
+            {
+                const cgi::type::glyph_t &g = this->glyphs[(unsigned char)ch];
+                if (g.present)
+                    return &g;
+
+                const cgi::type::glyph_t &fallback = this->glyphs[(unsigned char)'?'];
+                return fallback.present ? &fallback : nullptr;
+            }
+
+            /// @brief used to read one row of a glyph as bits, bit i is column i of the glyph
+            /// @param g glyph returned by glyph()
+            /// @param y_pos row of the glyph, 0 to height()-1
+            /// @return the row bits, 0 below the glyph
+            inline cgi::type::mask_word_t glyph_row(const cgi::type::glyph_t &g, int y_pos) const noexcept
+            {
+                if (y_pos < 0 || y_pos >= g.height || g.width == 0)
+                    return 0;
+
+                const cgi::type::mask_word_t *words = this->atlas.row(y_pos);
+                const int k = g.x >> 6;
+                const int shift = g.x & 63;
+
+                cgi::type::mask_word_t bits = words[k] >> shift;
+                if (shift && shift + g.width > 64)
+                    bits |= words[k + 1] << (64 - shift);
+
+                return g.width == 64 ? bits : (bits & (((cgi::type::mask_word_t)1 << g.width) - 1));
+            }
+
+            /// @brief measures text as draw_text would lay it out
+            /// @param text text to measure, '\n' starts a new line
+            /// @param scale integer scale of every glyph pixel
+            /// @param spacing gap between glyphs and between lines before scaling
+            /// @return width of the widest line in pixels
+            int text_width(std::string_view text, int scale = 1, int spacing = 1) const noexcept
+            {
+                int widest = 0, width = 0, glyphs_on_line = 0;
+                for (char ch : text)
+                {
+                    if (ch == '\n')
+                    {
+                        widest = std::max(widest, width);
+                        width = 0;
+                        glyphs_on_line = 0;
+                        continue;
+                    }
+
+                    const cgi::type::glyph_t *g = this->glyph(ch);
+                    if (!g)
+                        continue;
+
+                    width += (glyphs_on_line ? spacing : 0) + g->advance;
+                    glyphs_on_line++;
+                }
+                return std::max(widest, width) * std::max(scale, 0);
+            }
 
+            /// @brief measures the height of text as draw_text would lay it out
+            /// @param text text to measure, '\n' starts a new line
+            /// @param scale integer scale of every glyph pixel
+            /// @param spacing gap between glyphs and between lines before scaling
+            /// @return height in pixels
+            int text_height(std::string_view text, int scale = 1, int spacing = 1) const noexcept
+            {
+                const int lines = 1 + (int)std::count(text.begin(), text.end(), '\n');
+                return (lines * this->line_height + (lines - 1) * spacing) * std::max(scale, 0);
+            }
+        };
+    }
+}
 
 #endif
@@ -0,0 +1,1134 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_SURFACE_HPP
+#define CGI_SURFACE_HPP
+
+#pragma once
+
+#include "cgi_data_types.hpp"
+#include "cgi_blend.hpp"
+#include "cgi_convert.hpp"
+#include "cgi_dirty.hpp"
+#include "cgi_thread_pool.hpp"
+#include "cgi_mask.hpp"
+#include "cgi_image.hpp"
+#include "cgi_std_font_loader.hpp"
+#include "cgi_text_cache.hpp"
+#include <climits>
+
+namespace cgi
+{
+    namespace type
+    {
+        /// @brief one snapshot of a surface's size. stride is the distance between rows in pixels and is never smaller than width
+        struct geometry_t
+        {
+            int width = 0;
+            int height = 0;
+            int stride = 0;
+        };
+    }
+
+    /// @brief platform neutral pixel surface. owns the pixel buffer and every drawing primitive. cgi::window presents it through win32 and cgi::headless keeps it in memory only
+    class surface
+    {
+    protected:
+        cgi::type::color_t color = cgi::color::rgb(255, 255, 255);
+        cgi::type::buf_color_t buffer;
+
+        cgi::type::geometry_t geometry;
+        cgi::type::color_t *pixels = nullptr;
+
+        cgi::type::pixel_format_t format = cgi::type::pixel_format_t::COLORREF;
+        bool attached = false;
+
+        // damage since the last present, and everything drawn since the last clear
+        cgi::dirty_region damage;
+        cgi::dirty_region drawn;
+        bool clear_valid = false;
+        cgi::type::color_t clear_pixel = 0;
+
+        /// @brief forgets what is known about the content, everything has to be presented again
+        inline void touch_all() noexcept
+        {
+            this->damage.add_all();
+            this->clear_valid = false;
+        }
+
+        /// @brief restarts damage tracking for the current geometry
+        inline void reset_damage_bounds() noexcept
+        {
+            this->damage.set_bounds(this->geometry.width, this->geometry.height);
+            this->drawn.set_bounds(this->geometry.width, this->geometry.height);
+            this->touch_all();
+        }
+
+        /// @brief fills a rectangle with an already encoded pixel, split into tiles across the engine pool
+        inline void fill_area(const cgi::type::rect_t &area, cgi::type::color_t pixel)
+        {
+            cgi::engine::for_each_band(area.y, area.y + area.height, area.width, [&](int y0, int y1)
+                                       {
+                for (int y = y0; y < y1; y++)
+                {
+                    std::fill(this->span(area.x, y), this->span(area.x + area.width, y), pixel);
+                } });
+        }
+
+        /// @brief fills every row of the surface with an already encoded pixel
+        inline void fill_rows(cgi::type::color_t pixel)
+        {
+            this->fill_area({0, 0, this->geometry.width, this->geometry.height}, pixel);
+        }
+
+        /// @brief multiplies the opacity of packed pixels by alpha8, premultiplied pixels get their color scaled too
+        static inline void scale_alpha(cgi::type::color_t *pixels, int count, int alpha8, bool premultiplied) noexcept
+        {
+            for (int j = 0; j < count; j++)
+            {
+                const cgi::type::color_t scaled = cgi::blend::blend_pixel(0, pixels[j], alpha8);
+                pixels[j] = premultiplied ? scaled : ((pixels[j] & 0x00ffffff) | (scaled & 0xff000000));
+            }
+        }
+
+        /// @brief calls fn(start, end) for every run of set bits in a word
+        template <typename fn_t>
+        static inline void each_run(cgi::type::mask_word_t bits, fn_t &&fn)
+        {
+            while (bits)
+            {
+                const int s = cgi::type::mask_t::lowest_bit(bits);
+                const cgi::type::mask_word_t rest = ~(bits >> s);
+                const int len = rest ? cgi::type::mask_t::lowest_bit(rest) : 64 - s;
+
+                fn(s, s + len);
+
+                bits = (s + len >= 64) ? 0 : (bits & ~((((cgi::type::mask_word_t)1 << len) - 1) << s));
+            }
+        }
+
+        /// @brief blends an already encoded pixel over a rectangle, clipped. does not mark damage
+        inline void blend_area(int x_pos, int y_pos, int width, int height, cgi::type::color_t pixel, int alpha8) noexcept
+        {
+            const int x0 = std::max(x_pos, 0);
+            const int y0 = std::max(y_pos, 0);
+            const int x1 = std::min(x_pos + width, this->geometry.width);
+            const int y1 = std::min(y_pos + height, this->geometry.height);
+
+            if (alpha8 <= 0 || x0 >= x1 || y0 >= y1)
+                return;
+
+            for (int y = y0; y < y1; y++)
+                cgi::blend::span_fill(this->span(x0, y), x1 - x0, pixel, alpha8);
+        }
+
+        /// @brief draws one scaled glyph from the font atlas with encoded colors. does not mark damage
+        void draw_glyph(int x_pos, int y_pos, const cgi::type::font_t &font, const cgi::type::glyph_t &g, int scale, cgi::type::color_t fg, int fg_alpha, cgi::type::color_t bg, int bg_alpha) noexcept
+        {
+            if (x_pos >= this->geometry.width || x_pos + g.advance * scale <= 0)
+                return;
+
+            const cgi::type::mask_word_t cell = g.advance >= 64 ? ~(cgi::type::mask_word_t)0 : (((cgi::type::mask_word_t)1 << g.advance) - 1);
+
+            for (int gy = 0; gy < font.height(); gy++)
+            {
+                const int top = y_pos + gy * scale;
+                if (top >= this->geometry.height)
+                    break;
+                if (top + scale <= 0)
+                    continue;
+
+                const cgi::type::mask_word_t bits = font.glyph_row(g, gy);
+
+                each_run(bits, [&](int s, int e)
+                         { this->blend_area(x_pos + s * scale, top, (e - s) * scale, scale, fg, fg_alpha); });
+
+                if (bg_alpha > 0)
+                    each_run(~bits & cell, [&](int s, int e)
+                             { this->blend_area(x_pos + s * scale, top, (e - s) * scale, scale, bg, bg_alpha); });
+            }
+        }
+
+        /// @brief finds the surface rows [first, end) a buffer of rows covers at y_pos and the widest visible part of them
+        /// @return the clipped bounds, empty if nothing is visible
+        template <typename rows_t>
+        inline cgi::type::rect_t clip_rows(int x_pos, int y_pos, const rows_t &rows) const noexcept
+        {
+            const int first = std::max(0, -y_pos);
+            const int end = std::min((int)rows.size(), this->geometry.height - y_pos);
+
+            int widest = 0;
+            for (int i = first; i < end; i++)
+            {
+                widest = std::max(widest, (int)rows[i].size());
+            }
+
+            const int x0 = std::max(x_pos, 0);
+            const int x1 = std::min(x_pos + widest, this->geometry.width);
+
+            if (first >= end || x0 >= x1)
+                return {0, 0, 0, 0};
+
+            return {x0, y_pos + first, x1 - x0, end - first};
+        }
+
+    public:
+        surface() = default;
+
+        /// @brief creates a surface of given size filled with the base color
+        /// @param width width of the surface in pixels
+        /// @param height height of the surface in pixels
+        /// @param color base color of the surface
+        surface(int width, int height, cgi::type::color_t color)
+        {
+            this->color = color;
+            this->resize(width, height);
+        }
+
+        virtual ~surface() = default;
+
+        /// @brief resizes the surface. the storage only grows, with some headroom, so a shrink or a small grow reuses it without allocating. an attached surface gets its own storage again
+        /// @param width new width in pixels
+        /// @param height new height in pixels
+        /// @param keep_content true to keep the pixels the old and new size share (top left aligned) and fill only the new area with the base color, false to fill everything
+        /// @return true if resized otherwise false
+        bool resize(int width, int height, bool keep_content = false)
+        {
+            if (width < 0)
+                width = 0;
+            if (height < 0)
+                height = 0;
+
+            const int old_width = this->geometry.width;
+            const int old_height = this->geometry.height;
+            const int old_stride = this->geometry.stride;
+            const size_t count = (size_t)width * (size_t)height;
+            const cgi::type::color_t fill = this->encode(this->color);
+
+            const int rows = keep_content && this->pixels ? std::min(old_height, height) : 0;
+            const int cols = std::min(old_width, width);
+
+            try
+            {
+                if (this->attached)
+                {
+                    // the old pixels live in memory the surface does not own, copy the shared part out
+                    this->buffer.assign(count, fill);
+                    for (int y = 0; y < rows; y++)
+                        std::copy(this->pixels + (size_t)y * old_stride, this->pixels + (size_t)y * old_stride + cols, this->buffer.data() + (size_t)y * width);
+                }
+                else
+                {
+                    const size_t needed = std::max(count, (size_t)old_width * old_height);
+                    if (needed > this->buffer.capacity())
+                        this->buffer.reserve(std::max(needed, this->buffer.capacity() + this->buffer.capacity() / 2));
+
+                    if (rows == 0)
+                    {
+                        this->buffer.assign(count, fill);
+                    }
+                    else
+                    {
+                        if (this->buffer.size() < needed)
+                            this->buffer.resize(needed);
+
+                        // rows move in place: towards the front when they get narrower, towards the back when they get wider
+                        cgi::type::color_t *p = this->buffer.data();
+                        if (width <= old_width)
+                        {
+                            for (int y = 0; y < rows; y++)
+                                std::copy(p + (size_t)y * old_width, p + (size_t)y * old_width + cols, p + (size_t)y * width);
+                        }
+                        else
+                        {
+                            for (int y = rows - 1; y >= 0; y--)
+                                std::copy_backward(p + (size_t)y * old_width, p + (size_t)y * old_width + cols, p + (size_t)y * width + cols);
+                        }
+
+                        for (int y = 0; y < rows; y++)
+                            std::fill(p + (size_t)y * width + cols, p + (size_t)(y + 1) * width, fill);
+                        std::fill(p + (size_t)rows * width, p + count, fill);
+
+                        this->buffer.resize(count);
+                    }
+                }
+
+                this->geometry = {width, height, width};
+                this->pixels = this->buffer.data();
+                this->attached = false;
+                this->reset_damage_bounds();
+                return true;
+            }
+            catch (...)
+            {
+                this->geometry = {};
+                this->pixels = nullptr;
+                this->attached = false;
+                this->reset_damage_bounds();
+                std::cout << "error allocating surface of size " << width << 'x' << height << std::endl;
+                return false;
+            }
+        }
+
+        /// @brief used to get how many pixels the surface can hold before resize() has to allocate again
+        /// @return capacity in pixels, 0 while attached
+        inline size_t capacity() const noexcept
+        {
+            return this->buffer.capacity();
+        }
+
+        /// @brief makes the surface draw straight into memory it does not own, e.g. a dib section. the memory must outlive the attachment and is not cleared
+        /// @param memory first pixel of the top row
+        /// @param width width in pixels
+        /// @param height height in pixels
+        /// @param stride distance between rows in pixels (at least width)
+        /// @return true if attached otherwise false
+        bool attach(cgi::type::color_t *memory, int width, int height, int stride)
+        {
+            if (memory == nullptr || width < 0 || height < 0 || stride < width)
+            {
+                std::cout << "cannot attach surface to invalid memory" << std::endl;
+                return false;
+            }
+
+            this->buffer.clear();
+            this->buffer.shrink_to_fit();
+
+            this->geometry = {width, height, stride};
+            this->pixels = memory;
+            this->attached = true;
+            this->reset_damage_bounds();
+            return true;
+        }
+
+        /// @brief checks if the surface draws into memory it does not own
+        /// @return true if attached with attach()
+        inline bool is_attached() const noexcept
+        {
+            return this->attached;
+        }
+
+        /// @brief used to get the layout of the stored pixels. row() and span() expose this layout, use encode() and decode() when touching them directly
+        /// @return current pixel format
+        inline cgi::type::pixel_format_t pixel_format() const noexcept
+        {
+            return this->format;
+        }
+
+        /// @brief changes the layout of the stored pixels and converts the current content in place
+        /// @param format new pixel format
+        void set_pixel_format(cgi::type::pixel_format_t format) noexcept
+        {
+            if (this->format == format)
+                return;
+
+            this->format = format;
+
+            for (int i = 0; i < this->geometry.height; i++)
+            {
+                cgi::convert::swap_red_blue(this->row(i), this->row(i), this->geometry.width);
+            }
+
+            this->touch_all();
+        }
+
+        /// @brief reports pixels changed outside the drawing functions, e.g. through row() or span(), so they get presented
+        /// @param x_pos left of the changed rectangle
+        /// @param y_pos top of the changed rectangle
+        /// @param width width in pixels
+        /// @param height height in pixels
+        inline void mark_dirty(int x_pos, int y_pos, int width, int height) noexcept
+        {
+            this->damage.add(x_pos, y_pos, width, height);
+            this->drawn.add(x_pos, y_pos, width, height);
+        }
+
+        /// @brief used to get the regions changed since the last present
+        /// @return constant reference to the damage
+        inline const cgi::dirty_region &get_damage() const noexcept
+        {
+            return this->damage;
+        }
+
+        /// @brief sets how many separate rectangles are tracked before they get merged (1 to cgi::dirty_region::capacity, default 8)
+        /// @param max_rects maximum rectangle count
+        inline void set_dirty_rect_limit(int max_rects) noexcept
+        {
+            this->damage.set_limit(max_rects);
+            this->drawn.set_limit(max_rects);
+        }
+
+        /// @brief converts an api color (cgi::type::color_t) to the stored pixel layout
+        /// @param color color in cgi::type::color_t layout
+        /// @return pixel ready to be written through row() or span()
+        inline cgi::type::color_t encode(cgi::type::color_t color) const noexcept
+        {
+            return this->format == cgi::type::pixel_format_t::BGRA ? cgi::convert::swap_red_blue(color) : color;
+        }
+
+        /// @brief converts a stored pixel back to an api color (cgi::type::color_t)
+        /// @param pixel pixel read through row() or span()
+        /// @return color in cgi::type::color_t layout
+        inline cgi::type::color_t decode(cgi::type::color_t pixel) const noexcept
+        {
+            return this->format == cgi::type::pixel_format_t::BGRA ? cgi::convert::swap_red_blue(pixel) : pixel;
+        }
+
+        /// @brief used to get the width of the surface
+        /// @return width of the surface in pixels
+        inline int get_surface_width() const noexcept
+        {
+            return this->geometry.width;
+        }
+
+        /// @brief used to get the height of the surface
+        /// @return height of the surface in pixels
+        inline int get_surface_height() const noexcept
+        {
+            return this->geometry.height;
+        }
+
+        /// @brief used to get the width, height and stride of the surface as one snapshot. only changes on resize
+        /// @return constant reference to the current geometry
+        inline const cgi::type::geometry_t &get_geometry() const noexcept
+        {
+            return this->geometry;
+        }
+
+        /// @brief used to get the distance between two rows of the surface
+        /// @return stride in pixels
+        inline int stride() const noexcept
+        {
+            return this->geometry.stride;
+        }
+
+        /// @brief used to get a pointer to the first pixel of a row. no bounds check, y must be inside the surface. pointer is invalidated on resize
+        /// @param y_pos row index from the top of the surface
+        /// @return pointer to width() pixels of that row
+        inline cgi::type::color_t *row(int y_pos) noexcept
+        {
+            return this->pixels + (size_t)y_pos * this->geometry.stride;
+        }
+
+        /// @brief const version of row()
+        /// @param y_pos row index from the top of the surface
+        /// @return pointer to width() pixels of that row
+        inline const cgi::type::color_t *row(int y_pos) const noexcept
+        {
+            return this->pixels + (size_t)y_pos * this->geometry.stride;
+        }
+
+        /// @brief used to get a pointer into a row starting at a column. no bounds check, the caller must have clipped the span already
+        /// @param x_pos column where the span starts
+        /// @param y_pos row of the span
+        /// @return pointer to the pixel at (x_pos,y_pos)
+        inline cgi::type::color_t *span(int x_pos, int y_pos) noexcept
+        {
+            return this->row(y_pos) + x_pos;
+        }
+
+        /// @brief reads a pixel without bounds checking. use only on pre-clipped regions
+        /// @param x_pos x position inside the surface
+        /// @param y_pos y position inside the surface
+        /// @return color stored at the point
+        inline cgi::type::color_t get_pixel_unchecked(int x_pos, int y_pos) const noexcept
+        {
+            return this->row(y_pos)[x_pos];
+        }
+
+        /// @brief writes a pixel without bounds checking or blending. use only on pre-clipped regions
+        /// @param x_pos x position inside the surface
+        /// @param y_pos y position inside the surface
+        /// @param color color to store at the point
+        inline void set_pixel_unchecked(int x_pos, int y_pos, cgi::type::color_t color) noexcept
+        {
+            this->row(y_pos)[x_pos] = color;
+        }
+
+        /// @brief used to get the base color (say the color the surface was created with)
+        /// @return returns the initial color the surface was created with (type: cgi::type::color_t)
+        inline cgi::type::color_t base_color() noexcept
+        {
+            return this->color;
+        }
+
+        /// @brief call when you want to clear the surface with a particular color(does not change the base color)
+        /// @param clear_color the cgi::type::color_t value for the clear_color
+        /// @return returns true if properly cleared the surface otherwise false
+        inline bool clear(cgi::type::color_t clear_color)
+        {
+            try
+            {
+
+                const cgi::type::color_t pixel = this->encode(clear_color);
+
+                // cleared with the same color last time: only what was drawn since then is different
+                if (this->clear_valid && this->clear_pixel == pixel)
+                {
+                    for (int i = 0; i < this->drawn.size(); i++)
+                    {
+                        const cgi::type::rect_t r = this->drawn.at(i);
+                        this->fill_area(r, pixel);
+                        this->damage.add(r);
+                    }
+                }
+                else
+                {
+                    this->fill_rows(pixel);
+                    this->damage.add_all();
+                }
+
+                this->drawn.reset();
+                this->clear_valid = true;
+                this->clear_pixel = pixel;
+
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+            // return;
+        }
+
+        /// @brief call when you want to clear the surface with the default base color
+        /// @return returns true if properly cleared the surface otherwise false
+        inline bool clear()
+        {
+            return this->clear(this->color);
+        }
+
+        /// @brief used to manually set or manipulate the pixel color in surface
+        /// @param x_pos x position where you want to set from top left corner of your surface
+        /// @param y_pos y position where you want to set from top left corner of your surface
+        /// @param color cgi::type::rgba_t value that you want to set
+        inline void set_pixel(int x_pos, int y_pos, cgi::type::rgba_t color)
+        {
+
+            if (x_pos < 0 || x_pos >= this->geometry.width || y_pos < 0 || y_pos >= this->geometry.height)
+            {
+                return;
+            }
+
+            const cgi::type::color_t src = this->encode(cgi::surface::pack(color));
+
+            cgi::blend::span_packed(this->span(x_pos, y_pos), &src, 1);
+            this->mark_dirty(x_pos, y_pos, 1, 1);
+
+            return;
+        }
+
+        /// @brief used to manually set or manipulate the pixel color in surface with a packed straight alpha color
+        /// @param x_pos x position where you want to set from top left corner of your surface
+        /// @param y_pos y position where you want to set from top left corner of your surface
+        /// @param color cgi::type::rgba8_t value that you want to set
+        inline void set_pixel(int x_pos, int y_pos, cgi::type::rgba8_t color)
+        {
+
+            if (x_pos < 0 || x_pos >= this->geometry.width || y_pos < 0 || y_pos >= this->geometry.height)
+            {
+                return;
+            }
+
+            const cgi::type::color_t src = this->encode(color.value);
+
+            cgi::blend::span_packed(this->span(x_pos, y_pos), &src, 1);
+            this->mark_dirty(x_pos, y_pos, 1, 1);
+
+            return;
+        }
+
+        /// @brief used to set the pixel of surface to a particular color
+        /// @param x_pos x position where you want to set from top left corner of your surface
+        /// @param y_pos y position where you want to set from top left corner of your surface
+        /// @param color_rgb color in rgb format with type cgi::type::color_t
+        /// @param alpha alpha channel value for the opacity of color from 0 to 1
+        inline void set_pixel(int x_pos, int y_pos, cgi::type::color_t color_rgb, float alpha = 1.0)
+        {
+
+            if (x_pos < 0 || x_pos >= this->geometry.width || y_pos < 0 || y_pos >= this->geometry.height)
+                return;
+
+            const int alpha8 = cgi::blend::to_alpha8(alpha);
+
+            if (alpha8 == 0)
+                return;
+
+            cgi::blend::span_fill(this->span(x_pos, y_pos), 1, this->encode(color_rgb), alpha8);
+            this->mark_dirty(x_pos, y_pos, 1, 1);
+
+            return;
+        }
+
+        /// @brief used to get the pixel of color at a definite point of the surface
+        /// @param x_pos x position where you want to get the pixel from top left corner of your surface
+        /// @param y_pos y position where you want to get the pixel from top left corner of your surface
+        /// @return color at the point or the base color if the point is outside the surface
+        inline cgi::type::color_t get_pixel(int x_pos, int y_pos)
+        {
+            if (y_pos < 0 || y_pos >= this->geometry.height || x_pos < 0 || x_pos >= this->geometry.width)
+            {
+                return this->color;
+            }
+
+            return this->decode(this->row(y_pos)[x_pos]);
+        }
+
+        /// @brief fills a rectangle with one color. clipped once per call, opaque colors are plain stores and translucent ones a span blend per row
+        /// @param x_pos x position of the top left corner with respect to surface's top left corner
+        /// @param y_pos y position of the top left corner with respect to surface's top left corner
+        /// @param width width of the rectangle in pixels
+        /// @param height height of the rectangle in pixels
+        /// @param color color in rgb format with type cgi::type::color_t
+        /// @param alpha alpha channel value for the opacity of color from 0 to 1
+        inline void fill_rect(int x_pos, int y_pos, int width, int height, cgi::type::color_t color, float alpha = 1.0)
+        {
+            const int alpha8 = cgi::blend::to_alpha8(alpha);
+            if (alpha8 == 0)
+                return;
+
+            const int x0 = std::max(x_pos, 0);
+            const int y0 = std::max(y_pos, 0);
+            const int x1 = std::min(x_pos + width, this->geometry.width);
+            const int y1 = std::min(y_pos + height, this->geometry.height);
+
+            if (x0 >= x1 || y0 >= y1)
+                return;
+
+            const cgi::type::rect_t area = {x0, y0, x1 - x0, y1 - y0};
+            const cgi::type::color_t pixel = this->encode(color);
+
+            if (alpha8 == 255)
+            {
+                this->fill_area(area, pixel);
+            }
+            else
+            {
+                cgi::engine::for_each_band(area.y, area.y + area.height, area.width, [&](int band_y0, int band_y1)
+                                           {
+                    for (int y = band_y0; y < band_y1; y++)
+                    {
+                        cgi::blend::span_fill(this->span(area.x, y), area.width, pixel, alpha8);
+                    } });
+            }
+
+            this->mark_dirty(area.x, area.y, area.width, area.height);
+        }
+
+        /// @brief fills a rectangle with an rgba color
+        /// @param x_pos x position of the top left corner with respect to surface's top left corner
+        /// @param y_pos y position of the top left corner with respect to surface's top left corner
+        /// @param width width of the rectangle in pixels
+        /// @param height height of the rectangle in pixels
+        /// @param color cgi::type::rgba_t value that you want to fill with
+        inline void fill_rect(int x_pos, int y_pos, int width, int height, cgi::type::rgba_t color)
+        {
+            const cgi::type::color_t packed = cgi::surface::pack(color);
+            this->fill_rect(x_pos, y_pos, width, height, packed & 0x00ffffff, (float)(packed >> 24) / 255.0f);
+        }
+
+        /// @brief fills a rectangle with a packed straight alpha color
+        /// @param x_pos x position of the top left corner with respect to surface's top left corner
+        /// @param y_pos y position of the top left corner with respect to surface's top left corner
+        /// @param width width of the rectangle in pixels
+        /// @param height height of the rectangle in pixels
+        /// @param color cgi::type::rgba8_t value that you want to fill with
+        inline void fill_rect(int x_pos, int y_pos, int width, int height, cgi::type::rgba8_t color)
+        {
+            this->fill_rect(x_pos, y_pos, width, height, color.value & 0x00ffffff, (float)color.alpha() / 255.0f);
+        }
+
+        /// @brief draws a horizontal line of one pixel thickness
+        /// @param x_pos x position where the line starts
+        /// @param y_pos y position of the line
+        /// @param length length of the line in pixels towards the right
+        /// @param color color in rgb format with type cgi::type::color_t
+        /// @param alpha alpha channel value for the opacity of color from 0 to 1
+        inline void hline(int x_pos, int y_pos, int length, cgi::type::color_t color, float alpha = 1.0)
+        {
+            this->fill_rect(x_pos, y_pos, length, 1, color, alpha);
+        }
+
+        /// @brief draws a vertical line of one pixel thickness
+        /// @param x_pos x position of the line
+        /// @param y_pos y position where the line starts
+        /// @param length length of the line in pixels downwards
+        /// @param color color in rgb format with type cgi::type::color_t
+        /// @param alpha alpha channel value for the opacity of color from 0 to 1
+        inline void vline(int x_pos, int y_pos, int length, cgi::type::color_t color, float alpha = 1.0)
+        {
+            const int alpha8 = cgi::blend::to_alpha8(alpha);
+            if (alpha8 == 0 || x_pos < 0 || x_pos >= this->geometry.width)
+                return;
+
+            const int y0 = std::max(y_pos, 0);
+            const int y1 = std::min(y_pos + length, this->geometry.height);
+
+            if (y0 >= y1)
+                return;
+
+            const cgi::type::color_t pixel = this->encode(color);
+            cgi::type::color_t *pix = this->span(x_pos, y0);
+
+            for (int y = y0; y < y1; y++, pix += this->geometry.stride)
+            {
+                *pix = alpha8 == 255 ? pixel : cgi::blend::blend_one(*pix, pixel, alpha8);
+            }
+
+            this->mark_dirty(x_pos, y0, 1, y1 - y0);
+        }
+
+        /// @brief used to draw a cgi::type::buf2_color_t object in surface
+        /// @param x_pos x position from where the drawing should begin with respect to surface's top left corner
+        /// @param y_pos y position from where the drawing should begin with respect to surface's top left corner
+        /// @param buffer cgi::type::buf2_color_t object that you want to draw
+        /// @param alpha alpha channel for opacity from 0 to 1
+        inline void draw_buf2_color_t(int x_pos, int y_pos, const cgi::type::buf2_color_t &buffer, float alpha = 1.0)
+        {
+
+            const int alpha8 = cgi::blend::to_alpha8(alpha);
+            if (alpha8 == 0)
+                return;
+
+            const cgi::type::rect_t area = this->clip_rows(x_pos, y_pos, buffer);
+            if (area.width == 0)
+                return;
+
+            const bool swap = this->format == cgi::type::pixel_format_t::BGRA;
+
+            cgi::engine::for_each_band(area.y, area.y + area.height, area.width, [&](int band_y0, int band_y1)
+                                       {
+                // only used when the surface stores bgra and the rows need converting first
+                static thread_local cgi::type::buf_color_t scratch;
+
+                for (int py = band_y0; py < band_y1; py++)
+                {
+                    const cgi::type::buf_color_t &line = buffer[py - y_pos];
+
+                    int j0 = area.x - x_pos;
+                    int j1 = std::min((int)line.size(), area.x + area.width - x_pos);
+
+                    if (j0 >= j1)
+                        continue;
+
+                    const cgi::type::color_t *src = line.data() + j0;
+
+                    if (swap)
+                    {
+                        if (scratch.size() < (size_t)(j1 - j0))
+                            scratch.resize(j1 - j0);
+
+                        cgi::convert::swap_red_blue(scratch.data(), src, j1 - j0);
+                        src = scratch.data();
+                    }
+
+                    cgi::blend::span_copy(this->span(x_pos + j0, py), src, j1 - j0, alpha8);
+                } });
+
+            this->mark_dirty(area.x, area.y, area.width, area.height);
+
+            return;
+        }
+
+        /// @brief used to draw an object of type cgi::type::map2_t to the surface directly
+        /// @param x_pos x position from where the drawing should begin with respect to surface's top left corner
+        /// @param y_pos  position from where the drawing should begin with respect to surface's top left corner
+        /// @param map cgi::type::map2_t object that you want to draw
+        /// @param color color to set where there is value
+        /// @param bg_color color to set where there is not value(optional)
+        inline void draw_map2_t(int x_pos, int y_pos, const cgi::type::map2_t &map, cgi::type::rgba_t color, std::optional<cgi::type::rgba_t> bg_color = std::nullopt)
+        {
+
+            const cgi::type::color_t fg = this->encode(cgi::surface::pack(color));
+            const cgi::type::color_t bg = bg_color.has_value() ? this->encode(cgi::surface::pack(bg_color.value())) : 0;
+
+            int dirty_x0 = INT_MAX, dirty_x1 = INT_MIN, dirty_y0 = INT_MAX, dirty_y1 = INT_MIN;
+
+            int size_i = map.size();
+            int py;
+            for (int i = 0; i < size_i; i++)
+            {
+                py = y_pos + i;
+
+                if (py < 0 || py >= this->geometry.height)
+                    continue;
+
+                int j = std::max(0, -x_pos);
+                int j1 = std::min((int)map[i].size(), this->geometry.width - x_pos);
+
+                // walk runs of equal cells so each run becomes one span blend
+                while (j < j1)
+                {
+                    const char cell = map[i][j];
+                    int run = j + 1;
+                    while (run < j1 && map[i][run] == cell)
+                        run++;
+
+                    const bool paint = cell == '1' || (cell == '0' && bg_color.has_value());
+
+                    if (paint)
+                    {
+                        const cgi::type::color_t pixel = cell == '1' ? fg : bg;
+                        cgi::blend::span_fill(this->span(x_pos + j, py), run - j, pixel & 0x00ffffff, (int)(pixel >> 24));
+
+                        dirty_x0 = std::min(dirty_x0, x_pos + j);
+                        dirty_x1 = std::max(dirty_x1, x_pos + run);
+                        dirty_y0 = std::min(dirty_y0, py);
+                        dirty_y1 = py + 1;
+                    }
+
+                    j = run;
+                }
+            }
+
+            if (dirty_x0 < dirty_x1)
+                this->mark_dirty(dirty_x0, dirty_y0, dirty_x1 - dirty_x0, dirty_y1 - dirty_y0);
+
+            return;
+        }
+
+        /// @brief used to draw a packed 1 bit mask. set bits are drawn with color, cleared bits with bg_color if given. whole zero words are skipped and runs of equal bits become one span each
+        /// @param x_pos x position from where the drawing should begin with respect to surface's top left corner
+        /// @param y_pos y position from where the drawing should begin with respect to surface's top left corner
+        /// @param mask cgi::type::mask_t object that you want to draw
+        /// @param color color to set where a bit is set
+        /// @param bg_color color to set where a bit is cleared(optional)
+        inline void draw_mask(int x_pos, int y_pos, const cgi::type::mask_t &mask, cgi::type::rgba_t color, std::optional<cgi::type::rgba_t> bg_color = std::nullopt)
+        {
+            const int b0 = std::max(0, -x_pos);
+            const int b1 = std::min(mask.width(), this->geometry.width - x_pos);
+            const int y0 = std::max(y_pos, 0);
+            const int y1 = std::min(y_pos + mask.height(), this->geometry.height);
+
+            if (b0 >= b1 || y0 >= y1)
+                return;
+
+            const cgi::type::color_t fg = this->encode(cgi::surface::pack(color));
+            const cgi::type::color_t bg = bg_color.has_value() ? this->encode(cgi::surface::pack(bg_color.value())) : 0;
+            const int fg_alpha = (int)(fg >> 24);
+            const int bg_alpha = bg_color.has_value() ? (int)(bg >> 24) : 0;
+
+            cgi::engine::for_each_band(y0, y1, b1 - b0, [&](int band_y0, int band_y1)
+                                       {
+                for (int py = band_y0; py < band_y1; py++)
+                {
+                    const cgi::type::mask_word_t *words = mask.row(py - y_pos);
+                    // line is the first visible pixel, mask column b0, so it never points before the row when x_pos is negative
+                    cgi::type::color_t *line = this->row(py) + x_pos + b0;
+
+                    // one pending run per color in mask columns, extended while runs keep touching across words
+                    int fg_start = b0, fg_end = b0, bg_start = b0, bg_end = b0;
+
+                    auto runs = [&](cgi::type::mask_word_t v, int base, int &start, int &end, cgi::type::color_t pixel, int alpha)
+                    {
+                        while (v)
+                        {
+                            const int s = cgi::type::mask_t::lowest_bit(v);
+                            const cgi::type::mask_word_t rest = ~(v >> s);
+                            const int len = rest ? cgi::type::mask_t::lowest_bit(rest) : 64 - s;
+
+                            if (end == base + s)
+                            {
+                                end += len;
+                            }
+                            else
+                            {
+                                cgi::blend::span_fill(line + (start - b0), end - start, pixel & 0x00ffffff, alpha);
+                                start = base + s;
+                                end = start + len;
+                            }
+
+                            v = (s + len >= 64) ? 0 : (v & ~((((cgi::type::mask_word_t)1 << len) - 1) << s));
+                        }
+                    };
+
+                    for (int k = b0 >> 6; k <= (b1 - 1) >> 6; k++)
+                    {
+                        const int lo = std::max(b0, k * 64) - k * 64;
+                        const int hi = std::min(b1, k * 64 + 64) - k * 64;
+                        const cgi::type::mask_word_t visible = (hi == 64 ? ~(cgi::type::mask_word_t)0 : (((cgi::type::mask_word_t)1 << hi) - 1)) & ~(((cgi::type::mask_word_t)1 << lo) - 1);
+
+                        const cgi::type::mask_word_t set = words[k] & visible;
+
+                        if (set)
+                            runs(set, k * 64, fg_start, fg_end, fg, fg_alpha);
+
+                        if (bg_alpha > 0)
+                        {
+                            const cgi::type::mask_word_t cleared = ~words[k] & visible;
+                            if (cleared)
+                                runs(cleared, k * 64, bg_start, bg_end, bg, bg_alpha);
+                        }
+                    }
+
+                    cgi::blend::span_fill(line + (fg_start - b0), fg_end - fg_start, fg & 0x00ffffff, fg_alpha);
+                    cgi::blend::span_fill(line + (bg_start - b0), bg_end - bg_start, bg & 0x00ffffff, bg_alpha);
+                } });
+
+            this->mark_dirty(x_pos + b0, y0, b1 - b0, y1 - y0);
+
+            return;
+        }
+
+        /// @brief draws text with a bitmap font. glyph rows are read straight from the font atlas and every run of set bits becomes one span per scaled row, nothing is allocated
+        /// @param x_pos x position of the top left corner of the text
+        /// @param y_pos y position of the top left corner of the text
+        /// @param text text to draw, '\n' starts a new line
+        /// @param font font to draw with
+        /// @param color color of the glyph pixels
+        /// @param scale integer scale of every glyph pixel
+        /// @param spacing gap between glyphs and between lines before scaling
+        /// @param bg_color color behind the glyphs and the gaps between them(optional)
+        inline void draw_text(int x_pos, int y_pos, std::string_view text, const cgi::type::font_t &font, cgi::type::rgba_t color, int scale = 1, int spacing = 1, std::optional<cgi::type::rgba_t> bg_color = std::nullopt)
+        {
+            if (font.empty() || scale <= 0 || text.empty())
+                return;
+
+            spacing = std::max(spacing, 0);
+
+            const cgi::type::color_t fg = this->encode(cgi::surface::pack(color));
+            const cgi::type::color_t bg = bg_color.has_value() ? this->encode(cgi::surface::pack(bg_color.value())) : 0;
+            const int fg_alpha = (int)(fg >> 24);
+            const int bg_alpha = bg_color.has_value() ? (int)(bg >> 24) : 0;
+            const int glyph_height = font.height() * scale;
+
+            int pen_x = x_pos, pen_y = y_pos, right = x_pos;
+            int glyphs_on_line = 0;
+
+            for (char ch : text)
+            {
+                if (ch == '\n')
+                {
+                    pen_x = x_pos;
+                    pen_y += glyph_height + spacing * scale;
+                    glyphs_on_line = 0;
+                    continue;
+                }
+
+                const cgi::type::glyph_t *g = font.glyph(ch);
+                if (!g)
+                    continue;
+
+                if (glyphs_on_line++ && spacing)
+                {
+                    this->blend_area(pen_x, pen_y, spacing * scale, glyph_height, bg & 0x00ffffff, bg_alpha);
+                    pen_x += spacing * scale;
+                }
+
+                this->draw_glyph(pen_x, pen_y, font, *g, scale, fg & 0x00ffffff, fg_alpha, bg & 0x00ffffff, bg_alpha);
+
+                pen_x += g->advance * scale;
+                right = std::max(right, pen_x);
+            }
+
+            this->mark_dirty(x_pos, y_pos, right - x_pos, pen_y + glyph_height - y_pos);
+
+            return;
+        }
+
+        /// @brief draws text with the built in font, see the font taking overload
+        /// @param x_pos x position of the top left corner of the text
+        /// @param y_pos y position of the top left corner of the text
+        /// @param text text to draw, '\n' starts a new line
+        /// @param color color of the glyph pixels
+        /// @param scale integer scale of every glyph pixel
+        /// @param spacing gap between glyphs and between lines before scaling
+        /// @param bg_color color behind the glyphs and the gaps between them(optional)
+        inline void draw_text(int x_pos, int y_pos, std::string_view text, cgi::type::rgba_t color, int scale = 1, int spacing = 1, std::optional<cgi::type::rgba_t> bg_color = std::nullopt)
+        {
+            this->draw_text(x_pos, y_pos, text, cgi::type::font_t::standard(), color, scale, spacing, bg_color);
+        }
+
+        /// @brief draws text through a run cache. the first call rasterizes the run into the cache, later calls with the same text, font, scale and spacing are one mask blit. for multi line text bg_color fills the whole bounding box of the run
+        /// @param x_pos x position of the top left corner of the text
+        /// @param y_pos y position of the top left corner of the text
+        /// @param text text to draw, '\n' starts a new line
+        /// @param cache cache holding the rasterized runs
+        /// @param font font to draw with
+        /// @param color color of the glyph pixels
+        /// @param scale integer scale of every glyph pixel
+        /// @param spacing gap between glyphs and between lines before scaling
+        /// @param bg_color color behind the glyphs(optional)
+        inline void draw_text(int x_pos, int y_pos, std::string_view text, cgi::text_cache &cache, const cgi::type::font_t &font, cgi::type::rgba_t color, int scale = 1, int spacing = 1, std::optional<cgi::type::rgba_t> bg_color = std::nullopt)
+        {
+            if (font.empty() || scale <= 0 || text.empty())
+                return;
+
+            this->draw_mask(x_pos, y_pos, cache.get(text, font, scale, spacing), color, bg_color);
+        }
+
+        /// @brief used to draw a contiguous cgi::type::image_t (or a view of one). clipped once per blit, rows in the surface's own format with no alpha are a straight copy
+        /// @param x_pos x position from where the drawing should begin with respect to surface's top left corner
+        /// @param y_pos y position from where the drawing should begin with respect to surface's top left corner
+        /// @param image image or sub-image view that you want to draw
+        /// @param alpha alpha channel for opacity from 0 to 1, multiplied with the image's own alpha
+        inline void draw_image(int x_pos, int y_pos, const cgi::type::image_t &image, float alpha = 1.0)
+        {
+            const int alpha8 = cgi::blend::to_alpha8(alpha);
+            if (alpha8 == 0 || image.empty())
+                return;
+
+            const int x0 = std::max(x_pos, 0);
+            const int y0 = std::max(y_pos, 0);
+            const int x1 = std::min(x_pos + image.width(), this->geometry.width);
+            const int y1 = std::min(y_pos + image.height(), this->geometry.height);
+
+            if (x0 >= x1 || y0 >= y1)
+                return;
+
+            const int count = x1 - x0;
+            const bool swap = image.format() != this->format;
+            const bool per_pixel = image.alpha_mode() != cgi::type::alpha_mode_t::NONE;
+            const bool premultiplied = image.alpha_mode() == cgi::type::alpha_mode_t::PREMULTIPLIED;
+
+            cgi::engine::for_each_band(y0, y1, count, [&](int band_y0, int band_y1)
+                                       {
+                // only used when the rows need converting or their alpha scaling first
+                static thread_local cgi::type::buf_color_t scratch;
+
+                for (int py = band_y0; py < band_y1; py++)
+                {
+                    const cgi::type::color_t *src = image.row(py - y_pos) + (x0 - x_pos);
+                    cgi::type::color_t *dst = this->span(x0, py);
+
+                    if (swap || (per_pixel && alpha8 < 255))
+                    {
+                        if (scratch.size() < (size_t)count)
+                            scratch.resize(count);
+
+                        if (swap)
+                            cgi::convert::swap_red_blue(scratch.data(), src, count);
+                        else
+                            std::copy(src, src + count, scratch.data());
+
+                        if (per_pixel && alpha8 < 255)
+                            this->scale_alpha(scratch.data(), count, alpha8, premultiplied);
+
+                        src = scratch.data();
+                    }
+
+                    if (premultiplied)
+                        cgi::blend::span_premultiplied(dst, src, count);
+                    else if (per_pixel)
+                        cgi::blend::span_packed(dst, src, count);
+                    else
+                        cgi::blend::span_copy(dst, src, count, alpha8);
+                } });
+
+            this->mark_dirty(x0, y0, count, y1 - y0);
+
+            return;
+        }
+
+        /// @brief used to draw an object of type cgi::type::buf2_rgba_t directly to surface
+        /// @param x_pos x position from where the drawing should begin with respect to surface's top left corner
+        /// @param y_pos y position from where the drawing should begin with respect to surface's top left corner
+        /// @param rgba_buffer cgi::type::buf2_rgba_t object that you want to draw
+        inline void draw_buf2_rgba_t(int x_pos, int y_pos, const cgi::type::buf2_rgba_t &rgba_buffer)
+        {
+
+            const cgi::type::rect_t area = this->clip_rows(x_pos, y_pos, rgba_buffer);
+            if (area.width == 0)
+                return;
+
+            cgi::engine::for_each_band(area.y, area.y + area.height, area.width, [&](int band_y0, int band_y1)
+                                       {
+                // rows are packed to 0xAABBGGRR once, then blended as a whole span
+                static thread_local cgi::type::buf_color_t scratch;
+
+                for (int py = band_y0; py < band_y1; py++)
+                {
+                    const cgi::type::buf_rgba_t &line = rgba_buffer[py - y_pos];
+
+                    int j0 = area.x - x_pos;
+                    int j1 = std::min((int)line.size(), area.x + area.width - x_pos);
+
+                    if (j0 >= j1)
+                        continue;
+
+                    if (scratch.size() < (size_t)(j1 - j0))
+                        scratch.resize(j1 - j0);
+
+                    for (int j = j0; j < j1; j++)
+                        scratch[j - j0] = this->encode(cgi::surface::pack(line[j]));
+
+                    cgi::blend::span_packed(this->span(x_pos + j0, py), scratch.data(), j1 - j0);
+                } });
+
+            this->mark_dirty(area.x, area.y, area.width, area.height);
+
+            return;
+        }
+
+        /// @brief used to draw an object of type cgi::type::buf2_rgba8_t directly to surface. on a COLORREF surface the rows are blended in place without any packing
+        /// @param x_pos x position from where the drawing should begin with respect to surface's top left corner
+        /// @param y_pos y position from where the drawing should begin with respect to surface's top left corner
+        /// @param rgba_buffer cgi::type::buf2_rgba8_t object that you want to draw
+        /// @param alpha whether the buffer holds straight or premultiplied colors, NONE draws it opaque
+        inline void draw_buf2_rgba8_t(int x_pos, int y_pos, const cgi::type::buf2_rgba8_t &rgba_buffer, cgi::type::alpha_mode_t alpha = cgi::type::alpha_mode_t::STRAIGHT)
+        {
+
+            const cgi::type::rect_t area = this->clip_rows(x_pos, y_pos, rgba_buffer);
+            if (area.width == 0)
+                return;
+
+            const bool swap = this->format == cgi::type::pixel_format_t::BGRA;
+
+            cgi::engine::for_each_band(area.y, area.y + area.height, area.width, [&](int band_y0, int band_y1)
+                                       {
+                // only used to swizzle rows for a BGRA surface
+                static thread_local cgi::type::buf_color_t scratch;
+
+                for (int py = band_y0; py < band_y1; py++)
+                {
+                    const cgi::type::buf_rgba8_t &line = rgba_buffer[py - y_pos];
+
+                    int j0 = area.x - x_pos;
+                    int j1 = std::min((int)line.size(), area.x + area.width - x_pos);
+
+                    if (j0 >= j1)
+                        continue;
+
+                    const cgi::type::color_t *src = &line[j0].value;
+                    if (swap)
+                    {
+                        if (scratch.size() < (size_t)(j1 - j0))
+                            scratch.resize(j1 - j0);
+
+                        cgi::convert::swap_red_blue(scratch.data(), src, j1 - j0);
+                        src = scratch.data();
+                    }
+
+                    cgi::type::color_t *dst = this->span(x_pos + j0, py);
+
+                    if (alpha == cgi::type::alpha_mode_t::PREMULTIPLIED)
+                        cgi::blend::span_premultiplied(dst, src, j1 - j0);
+                    else if (alpha == cgi::type::alpha_mode_t::STRAIGHT)
+                        cgi::blend::span_packed(dst, src, j1 - j0);
+                    else
+                        cgi::blend::span_copy(dst, src, j1 - j0, 255);
+                } });
+
+            this->mark_dirty(area.x, area.y, area.width, area.height);
+
+            return;
+        }
+
+        /// @brief packs an rgba_t into one 32 bit value with the fixed point opacity in the top byte (0xAABBGGRR)
+        /// @param color color to pack
+        /// @return packed color
+        static inline cgi::type::color_t pack(const cgi::type::rgba_t &color) noexcept
+        {
+            return cgi::blend::pack(color);
+        }
+    };
+}
+
+#endif
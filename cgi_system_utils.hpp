@@ -45,6 +45,7 @@ namespace cgi{
             //ASCII keys vary from 32 to 126
             //we can manage only them
             //as they are standard inputs
+            //these poll the os on every call, inside a cgi::window prefer window.get_keyboard() which is fed by the window's key messages
             inline bool is_ASCII_key_pressed(char key){
                 if(key>=97 && key<=122){
                     key = (char)(key-32);
@@ -0,0 +1,296 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_TEXT_CACHE_HPP
+#define CGI_TEXT_CACHE_HPP
+
+#pragma once
+
+#include "cgi_std_font_loader.hpp"
+#include <functional>
+#include <unordered_map>
+
+namespace cgi
+{
+    /// @brief least recently used cache of rasterized text runs. a run is keyed by (text, font, scale, spacing) and kept as one packed mask already scaled, so drawing the same label again is a single mask blit. runs are found through a hash index and ordered in an intrusive recency list, so hits and evictions cost the same at any capacity. lookups that hit allocate nothing
+    class text_cache
+    {
+    private:
+        struct entry
+        {
+            size_t hash = 0;
+            std::string text;
+            const cgi::type::font_t *font = nullptr;
+            int scale = 0;
+            int spacing = 0;
+            int newer = -1;
+            int older = -1;
+            cgi::type::mask_t mask;
+        };
+
+        std::vector<entry> entries;
+        std::unordered_multimap<size_t, int> index;
+        int newest = -1;
+        int oldest = -1;
+        size_t limit = 64;
+
+        unsigned long long hit_count = 0;
+        unsigned long long miss_count = 0;
+        unsigned long long eviction_count = 0;
+
+        static inline size_t key_hash(std::string_view text, const cgi::type::font_t &font, int scale, int spacing) noexcept
+        {
+            size_t hash = std::hash<std::string_view>()(text);
+            hash ^= std::hash<const void *>()(&font) + (size_t)0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= (((size_t)scale << 16) | (size_t)spacing) + (size_t)0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+
+        /// @brief takes an entry out of the recency list
+        inline void unlink(int i) noexcept
+        {
+            entry &e = this->entries[i];
+            if (e.newer >= 0)
+                this->entries[e.newer].older = e.older;
+            else
+                this->newest = e.older;
+
+            if (e.older >= 0)
+                this->entries[e.older].newer = e.newer;
+            else
+                this->oldest = e.newer;
+
+            e.newer = e.older = -1;
+        }
+
+        /// @brief puts an entry at the most recently used end of the list
+        inline void push_newest(int i) noexcept
+        {
+            entry &e = this->entries[i];
+            e.newer = -1;
+            e.older = this->newest;
+
+            if (this->newest >= 0)
+                this->entries[this->newest].newer = i;
+            else
+                this->oldest = i;
+
+            this->newest = i;
+        }
+
+        inline void unindex(int i) noexcept
+        {
+            auto range = this->index.equal_range(this->entries[i].hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == i)
+                {
+                    this->index.erase(it);
+                    return;
+                }
+            }
+        }
+
+    public:
+        /// @brief draws a run into a mask, same layout as surface::draw_text. used for misses and by cgi::display_list
+        /// @param mask mask resized to the run and filled
+        /// @param text text of the run, '\n' starts a new line
+        /// @param font font to draw with
+        /// @param scale integer scale of every glyph pixel
+        /// @param spacing gap between glyphs and between lines before scaling
+        static void rasterize(cgi::type::mask_t &mask, std::string_view text, const cgi::type::font_t &font, int scale, int spacing)
+        {
+            mask.resize(font.text_width(text, scale, spacing), font.text_height(text, scale, spacing));
+
+            int pen_x = 0, pen_y = 0, glyphs_on_line = 0;
+            for (char ch : text)
+            {
+                if (ch == '\n')
+                {
+                    pen_x = 0;
+                    pen_y += (font.height() + spacing) * scale;
+                    glyphs_on_line = 0;
+                    continue;
+                }
+
+                const cgi::type::glyph_t *g = font.glyph(ch);
+                if (!g)
+                    continue;
+
+                if (glyphs_on_line++)
+                    pen_x += spacing * scale;
+
+                for (int gy = 0; gy < g->height; gy++)
+                {
+                    const cgi::type::mask_word_t bits = font.glyph_row(*g, gy);
+                    if (!bits)
+                        continue;
+
+                    for (int gx = 0; gx < g->width; gx++)
+                    {
+                        if (!((bits >> gx) & 1))
+                            continue;
+
+                        for (int sy = 0; sy < scale; sy++)
+                            for (int sx = 0; sx < scale; sx++)
+                                mask.set(pen_x + gx * scale + sx, pen_y + gy * scale + sy, true);
+                    }
+                }
+
+                pen_x += g->advance * scale;
+            }
+        }
+
+        /// @brief creates an empty cache
+        /// @param capacity number of runs kept before the least recently used one is evicted
+        explicit text_cache(size_t capacity = 64)
+        {
+            this->set_capacity(capacity);
+        }
+
+        /// @brief used to get the rasterized run, rasterizing it on a miss. the reference stays valid until the next get() or clear()
+        /// @param text text of the run, '\n' starts a new line
+        /// @param font font to draw with, compared by address
+        /// @param scale integer scale of every glyph pixel
+        /// @param spacing gap between glyphs and between lines before scaling
+        /// @return mask with set bits where the glyphs are
+        const cgi::type::mask_t &get(std::string_view text, const cgi::type::font_t &font, int scale = 1, int spacing = 1)
+        {
+            scale = std::max(scale, 0);
+            spacing = std::max(spacing, 0);
+
+            const size_t hash = key_hash(text, font, scale, spacing);
+
+            auto range = this->index.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                entry &e = this->entries[it->second];
+                if (e.font == &font && e.scale == scale && e.spacing == spacing && e.text == text)
+                {
+                    if (this->newest != it->second)
+                    {
+                        this->unlink(it->second);
+                        this->push_newest(it->second);
+                    }
+                    this->hit_count++;
+                    return e.mask;
+                }
+            }
+
+            this->miss_count++;
+
+            // entries never move while the cache is below its capacity, the vector was reserved for it
+            int i;
+            if (this->entries.size() < this->limit)
+            {
+                this->entries.emplace_back();
+                i = (int)this->entries.size() - 1;
+            }
+            else
+            {
+                i = this->oldest;
+                this->unindex(i);
+                this->unlink(i);
+                this->eviction_count++;
+            }
+
+            entry &slot = this->entries[i];
+            slot.hash = hash;
+            slot.text.assign(text.data(), text.size());
+            slot.font = &font;
+            slot.scale = scale;
+            slot.spacing = spacing;
+            rasterize(slot.mask, text, font, scale, spacing);
+
+            this->index.emplace(hash, i);
+            this->push_newest(i);
+
+            return slot.mask;
+        }
+
+        /// @brief sets how many runs are kept, evicting the least recently used ones if there are more
+        /// @param capacity number of runs, at least 1
+        void set_capacity(size_t capacity)
+        {
+            this->limit = std::max<size_t>(capacity, 1);
+
+            // shrinking keeps the most recent runs and renumbers them, this is the only place entries move
+            if (this->entries.size() > this->limit)
+            {
+                std::vector<entry> kept;
+                kept.reserve(this->limit);
+                for (int i = this->newest; i >= 0 && kept.size() < this->limit; i = this->entries[i].older)
+                    kept.push_back(std::move(this->entries[i]));
+
+                this->eviction_count += this->entries.size() - kept.size();
+                this->entries = std::move(kept);
+                this->index.clear();
+                this->newest = this->oldest = -1;
+
+                // kept runs are newest first, pushing them oldest first rebuilds the same order
+                for (int i = (int)this->entries.size() - 1; i >= 0; i--)
+                {
+                    this->index.emplace(this->entries[i].hash, i);
+                    this->push_newest(i);
+                }
+            }
+
+            this->entries.reserve(this->limit);
+            this->index.reserve(this->limit);
+        }
+
+        /// @brief drops every run, call after reloading a font the cache has seen
+        void clear() noexcept
+        {
+            this->entries.clear();
+            this->index.clear();
+            this->newest = this->oldest = -1;
+        }
+
+        /// @brief used to get the number of cached runs
+        inline size_t size() const noexcept
+        {
+            return this->entries.size();
+        }
+
+        inline size_t capacity() const noexcept
+        {
+            return this->limit;
+        }
+
+        /// @brief number of get() calls answered from the cache
+        inline unsigned long long hits() const noexcept
+        {
+            return this->hit_count;
+        }
+
+        /// @brief number of get() calls that had to rasterize
+        inline unsigned long long misses() const noexcept
+        {
+            return this->miss_count;
+        }
+
+        /// @brief number of runs thrown out to make room
+        inline unsigned long long evictions() const noexcept
+        {
+            return this->eviction_count;
+        }
+
+        /// @brief sets the hit, miss and eviction counters back to 0
+        inline void reset_stats() noexcept
+        {
+            this->hit_count = 0;
+            this->miss_count = 0;
+            this->eviction_count = 0;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,241 @@
+// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_THREAD_POOL_HPP
+#define CGI_THREAD_POOL_HPP
+
+#pragma once
+
+#include "cgi_includes.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace cgi
+{
+
+    /// @brief non-owning reference to a callable taking a task index. it is two pointers, so handing a stack lambda to the pool never allocates. the callable must outlive the reference
+    class task_ref
+    {
+    private:
+        void *object = nullptr;
+        void (*call)(void *, int) = nullptr;
+
+    public:
+        task_ref() = default;
+
+        template <typename F>
+        task_ref(F &task) noexcept : object((void *)&task), call([](void *o, int i)
+                                                                  { (*(F *)o)(i); })
+        {
+        }
+
+        inline void operator()(int i) const
+        {
+            this->call(this->object, i);
+        }
+    };
+
+    /// @brief persistent worker threads for splitting whole surface work (clear, convert, big blits) into tiles. the calling thread always takes part, and a pool of one thread runs every task inline in order, which is fully deterministic
+    class thread_pool
+    {
+    private:
+        std::vector<std::thread> workers;
+
+        std::mutex lock;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::mutex submit;
+
+        cgi::task_ref task;
+        int task_count = 0;
+        std::atomic<int> next{0};
+        int active = 0;
+        unsigned long long generation = 0;
+        bool stopping = false;
+
+        // set on pool threads and while the caller runs a job, nested jobs then run inline
+        static inline thread_local bool inside = false;
+
+        inline void run_tasks() noexcept
+        {
+            int i;
+            while ((i = this->next.fetch_add(1)) < this->task_count)
+            {
+                this->task(i);
+            }
+        }
+
+        void worker_loop()
+        {
+            cgi::thread_pool::inside = true;
+            unsigned long long seen = 0;
+
+            for (;;)
+            {
+                std::unique_lock<std::mutex> guard(this->lock);
+                this->wake.wait(guard, [&]
+                                { return this->stopping || this->generation != seen; });
+
+                if (this->stopping)
+                    return;
+
+                seen = this->generation;
+                guard.unlock();
+
+                this->run_tasks();
+
+                guard.lock();
+                if (--this->active == 0)
+                    this->done.notify_one();
+            }
+        }
+
+    public:
+        /// @brief starts the workers
+        /// @param threads total thread count including the caller, 0 uses every hardware thread, 1 runs everything inline
+        explicit thread_pool(int threads = 0)
+        {
+            if (threads <= 0)
+                threads = (int)std::max(1u, std::thread::hardware_concurrency());
+
+            try
+            {
+                for (int i = 1; i < threads; i++)
+                {
+                    this->workers.emplace_back(&cgi::thread_pool::worker_loop, this);
+                }
+            }
+            catch (...)
+            {
+                std::cout << "could only start " << this->workers.size() + 1 << " render threads" << std::endl;
+            }
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> guard(this->lock);
+                this->stopping = true;
+            }
+            this->wake.notify_all();
+
+            for (std::thread &worker : this->workers)
+            {
+                worker.join();
+            }
+        }
+
+        /// @brief used to get the number of threads that run tasks, including the caller
+        /// @return thread count
+        inline int size() const noexcept
+        {
+            return (int)this->workers.size() + 1;
+        }
+
+        /// @brief runs task(0) .. task(count-1) across the pool and returns when all are done. tasks must not depend on each other's order. if the pool is busy with another caller's job, or this is called from inside a task, the tasks run inline
+        /// @param count number of tasks
+        /// @param task callable invoked as task(index) once per task index
+        template <typename F>
+        void parallel_for(int count, F &&task)
+        {
+            if (count <= 0)
+                return;
+
+            if (this->workers.empty() || count == 1 || cgi::thread_pool::inside || !this->submit.try_lock())
+            {
+                for (int i = 0; i < count; i++)
+                    task(i);
+                return;
+            }
+
+            std::lock_guard<std::mutex> submitted(this->submit, std::adopt_lock);
+
+            {
+                std::lock_guard<std::mutex> guard(this->lock);
+                this->task = cgi::task_ref(task);
+                this->task_count = count;
+                this->next = 0;
+                this->active = (int)this->workers.size();
+                this->generation++;
+            }
+            this->wake.notify_all();
+
+            cgi::thread_pool::inside = true;
+            this->run_tasks();
+            cgi::thread_pool::inside = false;
+
+            std::unique_lock<std::mutex> guard(this->lock);
+            this->done.wait(guard, [&]
+                            { return this->active == 0; });
+            this->task = cgi::task_ref();
+        }
+    };
+
+    namespace engine
+    {
+        inline std::unique_ptr<cgi::thread_pool> &pool_slot()
+        {
+            static std::unique_ptr<cgi::thread_pool> slot(new cgi::thread_pool(0));
+            return slot;
+        }
+
+        /// @brief the engine owned pool used by every surface. created on first use with one thread per hardware thread
+        /// @return reference to the pool
+        inline cgi::thread_pool &pool()
+        {
+            return *cgi::engine::pool_slot();
+        }
+
+        /// @brief replaces the engine pool. call before rendering starts or between frames, never while a surface is drawing
+        /// @param threads total thread count, 0 uses every hardware thread, 1 makes all surface work single threaded and deterministic
+        inline void set_thread_count(int threads)
+        {
+            cgi::engine::pool_slot().reset(new cgi::thread_pool(threads));
+        }
+
+        /// @brief pixels handled by one tile, sized to stay inside a core's cache
+        constexpr long long tile_pixels = 32 * 1024;
+
+        /// @brief splits rows [y0, y1) of width pixels into cache sized bands and runs band(first_row, end_row) across the engine pool. small areas run inline
+        /// @param y0 first row
+        /// @param y1 one past the last row
+        /// @param width pixels per row
+        /// @param band callable invoked as band(first_row, end_row), called directly on the inline path so small areas never allocate
+        template <typename F>
+        inline void for_each_band(int y0, int y1, int width, F &&band)
+        {
+            const int rows = y1 - y0;
+            if (rows <= 0 || width <= 0)
+                return;
+
+            const int band_rows = (int)std::max(1LL, cgi::engine::tile_pixels / width);
+            const int bands = (rows + band_rows - 1) / band_rows;
+
+            if (bands < 4)
+            {
+                band(y0, y1);
+                return;
+            }
+
+            cgi::engine::pool().parallel_for(bands, [&](int i)
+                                             {
+                const int first = y0 + i * band_rows;
+                band(first, std::min(first + band_rows, y1)); });
+        }
+    }
+}
+
+#endif
@@ -15,10 +15,101 @@
 
 namespace cgi{
     namespace values{
+        /// @brief how cgi::window::run_as schedules frames
+        /// ON_EVENT: sleeps on the message queue and runs a frame only after input, a resize, a timer or request_redraw()
+        /// ASYNC_EVENT: runs a frame every period whether anything changed or not (default)
         enum class REFRESH_TYPE{
             ON_EVENT,
             ASYNC_EVENT
         };
+
+        /// @brief memory layout of the pixels stored in a surface
+        /// COLORREF: same as cgi::type::color_t (0x00BBGGRR), converted to the dib on every present
+        /// BGRA: the native 32 bit dib layout (0x00RRGGBB), drawn straight into the dib so present is only a blit
+        enum class PIXEL_FORMAT{
+            COLORREF,
+            BGRA
+        };
+
+        /// @brief how the top byte of an image pixel is used
+        /// NONE: ignored, the image is opaque
+        /// STRAIGHT: per pixel opacity, color channels are not multiplied by it
+        /// PREMULTIPLIED: per pixel opacity, color channels are already multiplied by it
+        enum class ALPHA_MODE{
+            NONE,
+            STRAIGHT,
+            PREMULTIPLIED
+        };
+
+        /// @brief color space the translucent blends run in
+        /// SRGB: blends the stored values directly, fastest and uses the simd kernels
+        /// LINEAR: converts to linear light and back through lookup tables, correct looking edges and gradients at a few table reads per channel
+        enum class BLEND_MODE{
+            SRGB,
+            LINEAR
+        };
+
+        /// @brief how a frame pacer waits for the next frame
+        /// UNCAPPED: never waits, frames run as fast as they are produced
+        /// SLEEP: sleeps until the deadline, cheap but wakes up late by the scheduler's granularity
+        /// HYBRID: sleeps until shortly before the deadline, then spins the rest. the margin follows the measured sleep error
+        enum class PACING_MODE{
+            UNCAPPED,
+            SLEEP,
+            HYBRID
+        };
+
+        /// @brief parts of a frame that are timed separately
+        /// PUMP: handling window messages, UPDATE: the user update function, LOAD_VIEW: converting damage into the dib,
+        /// BLIT: copying the dib to the screen, WAIT: pacing to the refresh rate, FRAME: the whole frame
+        enum class FRAME_PHASE{
+            PUMP,
+            UPDATE,
+            LOAD_VIEW,
+            BLIT,
+            WAIT,
+            FRAME,
+            COUNT
+        };
+
+        /// @brief mouse buttons tracked by the window, X1 and X2 are the side buttons
+        enum class MOUSE_BUTTON{
+            LEFT,
+            RIGHT,
+            MIDDLE,
+            X1,
+            X2,
+            COUNT
+        };
+
+        /// @brief kinds of recorded input events
+        enum class INPUT_EVENT{
+            KEY_DOWN,
+            KEY_UP,
+            CHAR,
+            MOUSE_MOVE,
+            MOUSE_DOWN,
+            MOUSE_UP,
+            WHEEL,
+            RESIZE,
+            FOCUS_LOST
+        };
+
+        /// @brief how a frame recorder writes frames
+        /// RAW: one file of frames back to back, 4 bytes per pixel in R,G,B,X order with no header (ffmpeg -f rawvideo -pixel_format rgb0), every frame has the size given when recording started
+        /// PPM: one binary ppm per frame, QOI: one qoi per frame. sequence files are numbered by frame index
+        enum class RECORD_FORMAT{
+            RAW,
+            PPM,
+            QOI
+        };
+
+        /// @brief what a frame recorder does when every buffer is still waiting to be written
+        /// DROP: skips the frame and counts it, the frame loop never waits. BLOCK: waits for a free buffer, no frame is lost
+        enum class BACKPRESSURE{
+            DROP,
+            BLOCK
+        };
     }
 }
 
@@ -10,7 +10,16 @@
 
 
 #include "cgi_data_types.hpp"
+#include "cgi_surface.hpp"
+#include "cgi_display_list.hpp"
 #include "cgi_std_font_loader.hpp"
+#include "cgi_frame_pacer.hpp"
+#include "cgi_frame_stats.hpp"
+#include "cgi_present_queue.hpp"
+#include "cgi_keyboard.hpp"
+#include "cgi_mouse.hpp"
+#include "cgi_input_queue.hpp"
+#include "cgi_frame_recorder.hpp"
 #include "cgi_system_utils.hpp"
 #include <chrono>
 #include <thread>
@@ -33,7 +42,6 @@ namespace cgi
         int width = 0;
         int height = 0;
         cgi::type::color_t color = cgi::type::rgba_t(255, 255, 255).value();
-        cgi::type::buf_color_t buffer;
 
         WNDCLASSA wc = {};
         HWND hwnd = nullptr;
@@ -45,6 +53,10 @@ namespace cgi
         DWORD *pixel = nullptr;
         PAINTSTRUCT ps;
 
+        // size the dib was made for, it is reused for any client area that fits
+        int dib_width = 0;
+        int dib_height = 0;
+
         float scroll_x = 0;
         float scroll_y = 0;
         double threshold_frame_period = 0;
@@ -72,8 +84,8 @@ namespace cgi
 
 
     
-    /// @brief use this class to create a window . write cgi::window window_name for window creation
-    class window
+    /// @brief use this class to create a window . write cgi::window window_name for window creation. all drawing is inherited from cgi::surface, the window only presents it
+    class window : public cgi::surface
     {
     private:
         const char *name;
@@ -89,6 +101,35 @@ namespace cgi
         bool first_log = true;
 
         bool resized = false;
+
+        cgi::frame_pacer pacer;
+        cgi::frame_stats stats;
+
+        // pipelined present, 0 frames in flight presents synchronously from buffer_refresh
+        int present_latency = 0;
+        std::mutex view_lock;
+        cgi::present_queue presenter;
+
+        cgi::keyboard_state keys;
+        cgi::mouse_state mouse;
+        cgi::input_queue events;
+
+        // not owned, every presented frame is offered to it while it records
+        cgi::frame_recorder *recorder = nullptr;
+
+        // on event refresh, set by messages that can change what update draws and by request_redraw from any thread
+        cgi::type::refresh_t refresh_type = cgi::type::refresh_t::ASYNC_EVENT;
+        std::atomic<bool> redraw{true};
+        static constexpr UINT_PTR redraw_timer = 1;
+
+        // interactive resizing, the view is rebuilt at most once per throttle while the frame is dragged
+        bool keep_on_resize = false;
+        double resize_throttle = 0.05;
+        bool sizing = false;
+        bool view_pending = false;
+        long int pending_width = 0;
+        long int pending_height = 0;
+        std::chrono::steady_clock::time_point last_view_build;
         public:
         cgi_window_struct details;
         private:
@@ -103,26 +144,29 @@ namespace cgi
             this->details.scroll_y = 0;
 
             this->resized = false;
+            this->keys.begin_frame();
+            this->mouse.begin_frame();
             // this->first_log=false;
 
             return;
         }
 
+        /// @brief makes the dib and its memory dc. the dib may be larger than the client area, its rows are dib_width pixels apart
         void make_bmi(long int width, long int height)
         {
             cleanup();
 
-            this->details.height = height;
-            this->details.width = width;
+            this->details.dib_width = width;
+            this->details.dib_height = height;
 
             // making bmi
             this->details.bmi = {};
             this->details.bmi.bmiHeader.biBitCount = 32;
             this->details.bmi.bmiHeader.biCompression = BI_RGB;
-            this->details.bmi.bmiHeader.biHeight = -this->details.height;
+            this->details.bmi.bmiHeader.biHeight = -height;
             this->details.bmi.bmiHeader.biPlanes = 1;
             this->details.bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-            this->details.bmi.bmiHeader.biWidth = this->details.width;
+            this->details.bmi.bmiHeader.biWidth = width;
 
             this->details.window_dc = GetDC(this->details.hwnd);
             this->details.pixels_1D = nullptr;
@@ -137,36 +181,256 @@ namespace cgi
             return;
         }
 
+        /// @brief checks if a message should wake an ON_EVENT window for a frame: input, focus loss, resizes and timers
+        static inline bool is_wake_message(UINT msg) noexcept
+        {
+            switch (msg)
+            {
+            case WM_KEYDOWN:
+            case WM_KEYUP:
+            case WM_SYSKEYDOWN:
+            case WM_SYSKEYUP:
+            case WM_CHAR:
+            case WM_MOUSEMOVE:
+            case WM_MOUSELEAVE:
+            case WM_MOUSEWHEEL:
+            case WM_MOUSEHWHEEL:
+            case WM_LBUTTONDOWN:
+            case WM_LBUTTONUP:
+            case WM_RBUTTONDOWN:
+            case WM_RBUTTONUP:
+            case WM_MBUTTONDOWN:
+            case WM_MBUTTONUP:
+            case WM_XBUTTONDOWN:
+            case WM_XBUTTONUP:
+            case WM_KILLFOCUS:
+            case WM_SIZE:
+            case WM_EXITSIZEMOVE:
+            case WM_TIMER:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        /// @brief records a button message. the mouse is captured while any button is held so drags that leave the client area keep reporting
+        void mouse_button(HWND hwnd, cgi::type::mouse_button_t button, bool pressed, LPARAM lp) noexcept
+        {
+            this->mouse.move((int)(short)LOWORD(lp), (int)(short)HIWORD(lp));
+
+            cgi::type::input_event_t e;
+            e.kind = pressed ? cgi::type::input_kind_t::MOUSE_DOWN : cgi::type::input_kind_t::MOUSE_UP;
+            e.x = this->mouse.get_x();
+            e.y = this->mouse.get_y();
+            e.button = button;
+            this->events.record(e);
+
+            if (pressed)
+            {
+                if (!this->mouse.any_down())
+                    SetCapture(hwnd);
+                this->mouse.button_down(button);
+                return;
+            }
+
+            this->mouse.button_up(button);
+            if (!this->mouse.any_down() && GetCapture() == hwnd)
+                ReleaseCapture();
+        }
+
+        /// @brief dib size for a client area that no longer fits, with a quarter of headroom so a drag that keeps growing does not rebuild it every step
+        static inline long int dib_capacity(long int needed, long int current) noexcept
+        {
+            if (needed <= current)
+                return current;
+            return current == 0 ? needed : std::max(needed, current + current / 4);
+        }
+
+        /// @brief (re)builds the surface and the dib for a client area size. the dib is only rebuilt when the area outgrows it, otherwise the surface is resized in its storage. in BGRA format the surface is attached to the dib memory itself, otherwise it keeps its own buffer that load_view converts. when pipelined the surface always keeps its own buffer and the present thread is restarted
+        void build_view(long int width, long int height)
+        {
+            // frames in flight were drawn for the old size
+            this->presenter.stop();
+
+            const int old_width = this->geometry.width;
+            const int old_height = this->geometry.height;
+            const bool fits = this->details.pixel != nullptr && width <= this->details.dib_width && height <= this->details.dib_height;
+
+            this->details.width = width;
+            this->details.height = height;
+
+            if (this->present_latency > 0 || this->format != cgi::type::pixel_format_t::BGRA)
+            {
+                this->resize(width, height, this->keep_on_resize);
+                if (!fits)
+                    make_bmi(dib_capacity(width, this->details.dib_width), dib_capacity(height, this->details.dib_height));
+
+                if (this->present_latency > 0 && this->details.pixel)
+                {
+                    this->presenter.start(this->present_latency, [this](const cgi::present_queue::frame &f)
+                                          { this->present_frame(f); });
+                }
+                return;
+            }
+
+            bool parked = false;
+            if (!fits)
+            {
+                // the content may live in the dib that is about to be freed, park it in the surface's own buffer
+                if (this->keep_on_resize)
+                    parked = this->resize(width, height, true);
+
+                make_bmi(dib_capacity(width, this->details.dib_width), dib_capacity(height, this->details.dib_height));
+                if (!this->details.pixel)
+                    return;
+
+                if (parked)
+                {
+                    cgi::type::color_t *dib = (cgi::type::color_t *)this->details.pixel;
+                    for (int y = 0; y < height; y++)
+                        std::copy(this->row(y), this->row(y) + width, dib + (size_t)y * this->details.dib_width);
+                }
+            }
+
+            this->attach((cgi::type::color_t *)this->details.pixel, width, height, this->details.dib_width);
+
+            if (parked)
+                return;
+
+            if (!this->keep_on_resize)
+            {
+                this->clear();
+                return;
+            }
+
+            // the reused dib still holds the old content in place, only the newly exposed strips need the base color
+            const int rows = std::min(old_height, (int)height);
+            const cgi::type::color_t fill = this->encode(this->color);
+            if (width > old_width && rows > 0)
+                this->fill_area({old_width, 0, (int)width - old_width, rows}, fill);
+            if (height > rows)
+                this->fill_area({0, rows, (int)width, (int)height - rows}, fill);
+        }
+
+        /// @brief applies a new client area size: rebuilds the view, flags the resize and records it
+        void resize_view(long int width, long int height)
+        {
+            this->view_pending = false;
+            this->last_view_build = std::chrono::steady_clock::now();
+
+            if (!this->first_log)
+            {
+                this->resized = true;
+            }
+
+            build_view(width, height);
+
+            cgi::type::input_event_t e;
+            e.kind = cgi::type::input_kind_t::RESIZE;
+            e.x = this->details.width;
+            e.y = this->details.height;
+            this->events.record(e);
+        }
+
         inline void load_view() noexcept
         {
             // load
 
-            cgi::type::color_t color;
-            for (int i = 0; i < this->get_buffer_height(); i++)
+            // BGRA surfaces are drawn straight into the dib, nothing to convert
+            if (!this->attached && this->details.pixel != nullptr)
             {
-                for (int j = 0; j < this->get_buffer_width(); j++)
+                // only damaged regions differ from what the dib already holds
+                cgi::type::color_t *dib = (cgi::type::color_t *)this->details.pixel;
+
+                for (int i = 0; i < this->damage.size(); i++)
                 {
-                    color = this->details.buffer[i * this->details.width + j];
-                    this->details.pixel[i * this->details.width + j] = cgi::color::rgb(cgi::color::parse_blue(color), cgi::color::parse_green(color), cgi::color::parse_red(color));
+                    const cgi::type::rect_t r = this->damage.at(i);
+                    cgi::engine::for_each_band(r.y, r.y + r.height, r.width, [&](int y0, int y1)
+                                               { cgi::convert::swap_red_blue(dib + (size_t)y0 * this->details.dib_width + r.x, this->details.dib_width, this->span(r.x, y0), this->geometry.stride, r.width, y1 - y0); });
                 }
             }
+
+            this->damage.reset();
         }
 
-        inline void display_view(HDC draw_dc) noexcept
+        /// @brief runs on the present thread. uploads the damaged rectangles of a submitted frame into the dib and blits them
+        void present_frame(const cgi::present_queue::frame &f) noexcept
+        {
+            auto lap = std::chrono::steady_clock::now();
+
+            std::lock_guard<std::mutex> guard(this->view_lock);
+
+            cgi::type::color_t *dib = (cgi::type::color_t *)this->details.pixel;
+            if (dib == nullptr || f.width != this->details.width || f.height != this->details.height)
+                return;
+
+            const bool swap = this->format != cgi::type::pixel_format_t::BGRA;
+
+            for (int i = 0; i < f.damage.size(); i++)
+            {
+                const cgi::type::rect_t r = f.damage.at(i);
+                for (int y = r.y; y < r.y + r.height; y++)
+                {
+                    const cgi::type::color_t *src = f.pixels.data() + (size_t)y * f.width + r.x;
+                    cgi::type::color_t *dst = dib + (size_t)y * this->details.dib_width + r.x;
+
+                    if (swap)
+                        cgi::convert::swap_red_blue(dst, src, r.width);
+                    else
+                        std::copy(src, src + r.width, dst);
+                }
+            }
+
+            lap = this->stats.lap(cgi::type::phase_t::LOAD_VIEW, lap);
+
+            HDC dc = GetDC(this->details.hwnd);
+            if (dc)
+            {
+                for (int i = 0; i < f.damage.size(); i++)
+                {
+                    const cgi::type::rect_t r = f.damage.at(i);
+                    BitBlt(dc, r.x, r.y, r.width, r.height, this->details.window_mem_dc, r.x, r.y, SRCCOPY);
+                }
+                ReleaseDC(this->details.hwnd, dc);
+            }
+            GdiFlush();
+
+            this->stats.lap(cgi::type::phase_t::BLIT, lap);
+        }
+
+        inline void display_view(HDC draw_dc, const RECT &area) noexcept
         {
             // display
 
-            BitBlt(draw_dc, 0, 0, this->details.width, this->details.height, this->details.window_mem_dc, 0, 0, SRCCOPY);
+            BitBlt(draw_dc, area.left, area.top, area.right - area.left, area.bottom - area.top, this->details.window_mem_dc, area.left, area.top, SRCCOPY);
+
+            // the next frame writes into the dib directly, so queued gdi work on it must be done first
+            if (this->attached)
+                GdiFlush();
         }
 
         void cleanup() noexcept
         {
+            // frames still queued belong to the dib that is about to be freed, the next view starts from a full repaint anyway
+            this->presenter.stop();
+
+            // an attached surface points into the dib that is about to be freed
+            if (this->attached)
+            {
+                this->resize(0, 0);
+                this->details.pixel = nullptr;
+            }
+
             if (this->details.hbmi)
             {
                 DeleteObject(this->details.hbmi);
                 this->details.hbmi = nullptr;
             }
 
+            this->details.pixel = nullptr;
+            this->details.dib_width = 0;
+            this->details.dib_height = 0;
+
             if (this->details.hwnd && this->details.window_dc)
             {
                 ReleaseDC(this->details.hwnd, this->details.window_dc);
@@ -191,6 +455,7 @@ namespace cgi
             this->details.width = width;
             this->details.height = height;
             this->details.color = color;
+            this->color = color;
 
             // this->details.buffer.clear();
             // this->details.buffer.resize(this->details.height,std::vector<cgi::type::color_t>(this->details.width,this->details.color));
@@ -230,13 +495,6 @@ namespace cgi
             return;
         }
 
-        /// @brief used to get the base color (say the color the window was created with)
-        /// @return returns the initial color the window was created with (type: cgi::type::color_t)
-        inline cgi::type::color_t base_color() noexcept
-        {
-            return this->details.color;
-        }
-
         /// @brief used to get the width of window
         /// @return return current width of window in pixels
         inline long int get_width() noexcept
@@ -259,13 +517,11 @@ namespace cgi
             }
         }
 
-        /// @brief gets the buffer width of the window i.e. the client area width
+        /// @brief gets the buffer width of the window i.e. the client area width. served from the cached geometry, which only changes on WM_SIZE
         /// @return return the width of the client area or buffer area of window in pixels
         inline long int get_buffer_width() noexcept
         {
-            RECT rect_drawable = {};
-            GetClientRect(this->details.hwnd, &rect_drawable);
-            return (rect_drawable.right - rect_drawable.left);
+            return this->geometry.width;
         }
 
         /// @brief gets the total height of window including the default borders added by windows OS
@@ -295,22 +551,107 @@ namespace cgi
 
             
 
-        /// @brief used to get the height of the client area of buffer area of window
+        /// @brief used to pick the layout the window draws in before it is created. cgi::type::pixel_format_t::BGRA draws straight into the dib so presenting is only a BitBlt, COLORREF (default) keeps a separate buffer converted on every paint
+        /// @param format pixel format of the window surface
+        /// @return true if success false if the window is already created
+        inline bool set_pixel_format(cgi::type::pixel_format_t format) noexcept
+        {
+            if (this->created || this->open)
+            {
+                std::cout << "cannot set pixel format after window is created" << std::endl;
+                return false;
+            }
+
+            cgi::surface::set_pixel_format(format);
+            return true;
+        }
+
+        /// @brief turns on pipelined present: while a present thread uploads and blits frame N, run_as already draws frame N+1. call before create
+        /// @param frames frames that may be drawn but not yet shown. 0 presents synchronously (default), 1 is double buffering, 2 triple buffering, at most cgi::present_queue::max_latency
+        /// @return true if set, false if the window already exists
+        inline bool set_present_latency(int frames) noexcept
+        {
+            if (this->created || this->open)
+            {
+                std::cout << "cannot change present latency after window is created" << std::endl;
+                return false;
+            }
+
+            this->present_latency = std::min(std::max(frames, 0), cgi::present_queue::max_latency);
+            return true;
+        }
+
+        /// @brief picks how run_as schedules frames. ON_EVENT sleeps on the message queue and runs update only after input, a resize, a timer or request_redraw(), so an idle window uses no cpu. ASYNC_EVENT (default) runs every period
+        /// @param type refresh type
+        inline void set_refresh_type(cgi::type::refresh_t type) noexcept
+        {
+            this->refresh_type = type;
+            this->redraw.store(true, std::memory_order_relaxed);
+        }
+
+        inline cgi::type::refresh_t get_refresh_type() const noexcept
+        {
+            return this->refresh_type;
+        }
+
+        /// @brief asks an ON_EVENT window for one more frame. safe to call from any thread, e.g. when a worker has new data to show
+        inline void request_redraw() noexcept
+        {
+            this->redraw.store(true, std::memory_order_release);
+
+            // wakes run_as if it is waiting on the message queue
+            if (this->details.hwnd)
+                PostMessage(this->details.hwnd, WM_NULL, 0, 0);
+        }
+
+        /// @brief wakes an ON_EVENT window on a fixed interval, e.g. a dashboard that polls once a second. the window must exist
+        /// @param seconds time between wakes, 0 or less stops the timer
+        /// @return true if the timer was set or stopped
+        inline bool set_redraw_timer(double seconds) noexcept
+        {
+            if (!this->details.hwnd)
+            {
+                std::cout << "cannot set a redraw timer on an uncreated window" << std::endl;
+                return false;
+            }
+
+            if (seconds <= 0)
+                return KillTimer(this->details.hwnd, redraw_timer) != 0;
+
+            return SetTimer(this->details.hwnd, redraw_timer, (UINT)std::max(seconds * 1000, 1.0), nullptr) != 0;
+        }
+
+        /// @brief sets how the window reacts to being resized
+        /// @param keep_content true to keep the part of the picture the old and new size share and fill only the new area with the base color, false (default) to clear to the base color
+        /// @param throttle_seconds while the frame is being dragged the view is rebuilt at most this often, the final size is always applied when the drag ends. 0 rebuilds on every size message, less than 0 waits for the end of the drag (default 0.05)
+        inline void set_resize_policy(bool keep_content, double throttle_seconds = 0.05) noexcept
+        {
+            this->keep_on_resize = keep_content;
+            this->resize_throttle = throttle_seconds;
+        }
+
+        /// @brief used to get the frames that may be in flight, 0 when presenting synchronously
+        inline int get_present_latency() const noexcept
+        {
+            return this->present_latency;
+        }
+
+        /// @brief used to get the height of the client area of buffer area of window. served from the cached geometry, which only changes on WM_SIZE
         /// @return returns the height of the buffer area or client area in pixels
         inline long int get_buffer_height() noexcept
         {
-            RECT rect_drawable = {};
-            GetClientRect(this->details.hwnd, &rect_drawable);
-            return (rect_drawable.bottom - rect_drawable.top);
+            return this->geometry.height;
         }
 
-        /// @brief direectly return the pointer to the internal buffer of the window. address pointed by the pointer changes on some events like resizing  so always check before using
+        /// @brief direectly return the pointer to the internal buffer of the window. address pointed by the pointer changes on some events like resizing  so always check before using. in BGRA format the pixels live in the dib, use row() instead
         /// @return nullptr if no buffer present or the address  if present
         inline cgi::type::buf_color_t *get_buffer() noexcept
         {
-            if (this->is_open())
+            if (this->is_open() && !this->attached)
             {
-                return &this->details.buffer;
+                // writes through the vector are not tracked, so assume everything changes
+                this->touch_all();
+                return &this->buffer;
             }
             else
             {
@@ -350,8 +691,12 @@ namespace cgi
 
             ShowWindow(this->details.hwnd, SW_SHOW);
 
-            this->details.buffer.clear();
-            this->details.buffer.resize(this->get_buffer_height() * this->get_buffer_width(), this->details.color);
+            RECT rect_drawable = {};
+            GetClientRect(this->details.hwnd, &rect_drawable);
+            if (rect_drawable.right - rect_drawable.left != this->geometry.width || rect_drawable.bottom - rect_drawable.top != this->geometry.height)
+            {
+                this->build_view(rect_drawable.right - rect_drawable.left, rect_drawable.bottom - rect_drawable.top);
+            }
 
             UpdateWindow(this->details.hwnd);
             // std::cout<<"here";
@@ -424,233 +769,6 @@ namespace cgi
             return;
         }
 
-        /// @brief call when you want to clear the window with a particular color(does not change the base color)
-        /// @param clear_color the cgi::type::color_t value for the clear_color
-        /// @return returns true if properly cleared the window otherwise false
-        inline bool clear(cgi::type::color_t clear_color)
-        {
-            try
-            {
-
-                std::fill(this->details.buffer.begin(), this->details.buffer.end(), clear_color);
-
-                return true;
-            }
-            catch (...)
-            {
-                return false;
-            }
-            // return;
-        }
-
-        /// @brief call when you want to clear the window with the default base color of window
-        /// @return returns true if properly cleared the window otherwise false
-        inline bool clear() 
-        {
-
-            try
-            {
-
-                std::fill(this->details.buffer.begin(), this->details.buffer.end(), this->details.color);
-                return true;
-            }
-            catch (...)
-            {
-                return false;
-            }
-        }
-
-        /// @brief used to manually set or manipulate the pixel color in window
-        /// @param x_pos x position where you want to set from top left corner of your screen
-        /// @param y_pos y position where you want to set from top left corner of your screen
-        /// @param color cgi::type::rgba_t value that you want to set
-        inline void set_pixel(int x_pos, int y_pos, cgi::type::rgba_t color)
-        {
-
-            if (x_pos < 0 || x_pos >= this->details.width || y_pos < 0 || y_pos >= this->details.height)
-            {
-                return;
-            }
-
-            cgi::type::color_t pix = this->get_pixel(x_pos, y_pos);
-
-            // std::vector<int> pix_val = cgi::color::parse_rgb(this->get_pixel(x_pos, y_pos));
-
-            int r = color.red() * color.alpha() + cgi::color::parse_red(pix) * (1 - color.alpha());
-
-            int g = color.green() * color.alpha() + cgi::color::parse_green(pix) * (1 - color.alpha());
-            int b = color.blue() * color.alpha() + cgi::color::parse_blue(pix) * (1 - color.alpha());
-
-            this->details.buffer[y_pos * this->get_buffer_width() + x_pos] = cgi::color::rgb(r, g, b);
-
-            // std::cout<<r<<' '<<g<<' '<<b<<'\n';
-
-            return;
-        }
-
-        /// @brief used to set the pixel of window to a particular color
-        /// @param x_pos x position where you want to set from top left corner of your screen
-        /// @param y_pos y position where you want to set from top left corner of your screen
-        /// @param color_rgb color in rgb format with type cgi::type::color_t
-        /// @param alpha alpha channel value for the opacity of color from 0 to 1
-        inline void set_pixel(int x_pos, int y_pos, cgi::type::color_t color_rgb,float alpha=1.0)
-        {
-
-            if(x_pos<0 || x_pos>=this->details.width || y_pos<0 || y_pos>=this->details.height)
-            return;
-            
-
-            cgi::type::color_t pix = this->get_pixel(x_pos, y_pos);
-
-            int r = cgi::color::parse_red(color_rgb) * alpha + cgi::color::parse_red(pix) * (1 - alpha);
-            int g = cgi::color::parse_green(color_rgb) * alpha + cgi::color::parse_green(pix) * (1 - alpha);
-            int b = cgi::color::parse_blue(color_rgb) * alpha + cgi::color::parse_blue(pix) * (1 - alpha);
-
-            this->details.buffer[y_pos * this->get_buffer_width() + x_pos] = cgi::color::rgb(r, g, b);
-
-
-            // set_pixel(x_pos, y_pos, cgi::type::rgba_t(color_rgb, 1));
-
-            return;
-        }
-
-        /// @brief used to get the pixel of color at a definite point of the window
-        /// @param x_pos x position where you want to get the pixel from top left corner of your screen
-        /// @param y_pos y position where you want to get the pixel from top left corner of your screen
-        /// @return 
-        inline cgi::type::color_t get_pixel(int x_pos, int y_pos)
-        {
-            if (y_pos < 0 || y_pos >= this->details.height || x_pos < 0 || x_pos >= this->details.width)
-            {
-                return this->details.color;
-            }
-
-            return this->details.buffer[y_pos * this->get_buffer_width() + x_pos];
-        }
-
-        /// @brief used to draw a cgi::type::buf2_color_t object in window
-        /// @param x_pos x position from where the drawing should begin with respect to window's top left corner
-        /// @param y_pos y position from where the drawing should begin with respect to window's top left corner
-        /// @param buffer cgi::type::buf2_color_t object that you want to draw
-        /// @param alpha alpha channel for opacity from 0 to 1
-        inline void draw_buf2_color_t(int x_pos, int y_pos, const cgi::type::buf2_color_t &buffer, float alpha = 1.0)
-        {
-
-            int r, g, b;
-            int py, px;
-
-            for (int i = 0; i < buffer.size(); i++)
-            {
-                py = y_pos + i;
-
-                if (py < 0 || py >= this->details.height)
-                    continue;
-
-                for (int j = 0; j < buffer[i].size(); j++)
-                {
-                    px = x_pos + j;
-
-                    if (px < 0 || px >= this->details.width)
-                        continue;
-
-                    r = cgi::color::parse_red(buffer[i][j]);
-                    g = cgi::color::parse_green(buffer[i][j]);
-                    b = cgi::color::parse_blue(buffer[i][j]);
-
-                    set_pixel(px, py, cgi::type::rgba_t(r, g, b, alpha));
-                }
-            }
-
-            // InvalidateRect(this->details.hwnd,nullptr,TRUE);
-            // UpdateWindow(this->details.hwnd);
-
-            return;
-        }
-
-        /// @brief used to draw an object of type cgi::type::map2_t to the window directly
-        /// @param x_pos x position from where the drawing should begin with respect to window's top left corner
-        /// @param y_pos  position from where the drawing should begin with respect to window's top left corner
-        /// @param map cgi::type::map2_t object that you want to draw
-        /// @param color color to set where there is value
-        /// @param bg_color color to set where there is not value(optional)
-        inline void draw_map2_t(int x_pos, int y_pos, const cgi::type::map2_t &map, cgi::type::rgba_t color, std::optional<cgi::type::rgba_t> bg_color = std::nullopt)
-        {
-
-            int size_i = map.size();
-            int py, px;
-            for (int i = 0; i < size_i; i++)
-            {
-                py = y_pos + i;
-
-                if (py < 0 || py >= this->details.height)
-                    continue;
-
-                int size_j = map[i].size();
-
-                for (int j = 0; j < size_j; j++)
-                {
-                    px = x_pos + j;
-
-                    if (px < 0 || px >= this->details.width)
-                        continue;
-
-                    if (map[i][j] == '1')
-                    {
-                        // std::vector<int> pix = cgi::color::parse_rgb(get_pixel(px,py));
-
-                        set_pixel(px, py, color);
-                    }
-
-                    if (map[i][j] == '0')
-                    {
-                        if (bg_color.has_value())
-                        {
-                            set_pixel(px, py, bg_color.value());
-                        }
-
-                        continue;
-                    }
-                }
-            }
-
-            return;
-        }
-
-        /// @brief used to draw an object of type cgi::type::buf2_rgba_t directly to window
-        /// @param x_pos x position from where the drawing should begin with respect to window's top left corner
-        /// @param y_pos y position from where the drawing should begin with respect to window's top left corner
-        /// @param rgba_buffer cgi::type::buf2_rgba_t object that you want to draw 
-        inline void draw_buf2_rgba_t(int x_pos, int y_pos, const cgi::type::buf2_rgba_t &rgba_buffer)
-        {
-
-            int size_i = rgba_buffer.size();
-            int py, px;
-
-            for (int i = 0; i < size_i; i++)
-            {
-                py = y_pos + i;
-
-                if (py < 0 || py >= this->details.height)
-                {
-                    continue;
-                }
-
-                int size_j = rgba_buffer[i].size();
-
-                for (int j = 0; j < size_j; j++)
-                {
-                    px = x_pos + j;
-
-                    if (px < 0 || px >= this->details.width)
-                        continue;
-
-                    this->set_pixel(px, py, rgba_buffer[i][j]);
-                }
-            }
-
-            return;
-        }
-
         // inline void draw_buf2_rgba_t(int x_pos,int y_pos,const cgi::type::buf2_rgba_t rgba_buffer,int scale_x=1,int scale_y=1){
 
         //     for(int i=0;i<rgba_buffer.size();i++){
@@ -674,86 +792,6 @@ namespace cgi
 
         // }
 
-        // inline cgi::type::map2_t write(std::string text, const pen &p, cgi::type::rgba_t color, int x_pos, int y_pos, int scale_x = 1, int scale_y = 1, int space = 1, std::optional<cgi::type::rgba_t> bg_color = std::nullopt)
-        // {
-
-        //     cgi::type::map2_t map;
-
-        //     if (scale_x < 0)
-        //         scale_x = 0;
-        //     if (scale_y < 0)
-        //         scale_y = 0;
-        //     if (space < 0)
-        //         space = 0;
-
-        //     int row_at = 0;
-
-        //     map.resize(scale_y * p.get_style_height());
-        //     for (int i = 0; i < p.get_style_height(); i++)
-        //     {
-        //         for (int s = 0; s < scale_y; s++)
-        //         {
-
-        //             for (int j = 0; j < text.size(); j++)
-        //             {
-        //                 std::vector<cgi::type::map_t> line = p.get_style(text[j]);
-
-        //                 for (char c : line[i])
-        //                 {
-        //                     for (int k = 0; k < scale_x; k++)
-        //                     {
-        //                         map[row_at].push_back(c);
-        //                     }
-        //                 }
-
-        //                 if (j != text.size() - 1)
-        //                 {
-        //                     for (int k = 0; k < space; k++)
-        //                     {
-        //                         map[row_at].push_back('0');
-        //                     }
-        //                 }
-        //             }
-
-        //             row_at++;
-        //         }
-        //     }
-
-        //     // displaying final map for debugging
-        //     //  for (int i = 0; i < map.size(); i++)
-        //     //  {
-        //     //      for (int j = 0; j < map[i].size(); j++)
-        //     //      {
-        //     //          std::cout << map[i][j];
-        //     //      }
-        //     //      std::cout << '\n';
-        //     //  }
-
-        //     char ch;
-        //     for (int i = 0; i < map.size(); i++)
-        //     {
-        //         for (int j = 0; j < map[i].size(); j++)
-        //         {
-
-        //             ch = map[i][j];
-
-        //             if (ch == '1')
-        //             {
-        //                 this->set_pixel(j + x_pos, i + y_pos, color);
-        //             }
-        //             else if (ch == '0')
-        //             {
-        //                 if (bg_color.has_value())
-        //                 {
-        //                     this->set_pixel(j + x_pos, i + y_pos, bg_color.value());
-        //                 }
-        //             }
-        //         }
-        //     }
-
-        //     return map;
-        // }
-
         /// @brief used to check if a window is in focus
         /// @return returns true if focused or false
         inline bool is_focused() noexcept
@@ -815,18 +853,64 @@ namespace cgi
             return p.y;
         }
 
-        /// @brief used to get the x position of cursor in pixels with respect to the window client or buffer area
+        /// @brief used to get the x position of cursor in pixels with respect to the window client or buffer area, as of the last mouse message
         /// @return x position in pixels
-        int get_cursor_x() noexcept
+        inline int get_cursor_x() const noexcept
         {
-            return (cgi::system::cursor::get_x_pos() - this->get_buffer_x_pos());
+            return this->mouse.get_x();
         }
 
-        /// @brief used to get the y position of cursor in pixels with respect to the window client or buffer area
+        /// @brief used to get the y position of cursor in pixels with respect to the window client or buffer area, as of the last mouse message
         /// @return y position in pixels
-        int get_cursor_y() noexcept
+        inline int get_cursor_y() const noexcept
+        {
+            return this->mouse.get_y();
+        }
+
+        /// @brief used to get the mouse state built from this window's mouse messages: position, motion, wheel and buttons of the current frame
+        /// @return constant reference to the window's mouse state
+        inline const cgi::mouse_state &get_mouse() const noexcept
+        {
+            return this->mouse;
+        }
+
+        /// @brief turns the input event queue on or off (off by default). while on, every key, character, mouse, wheel, resize and focus message is queued with a timestamp
+        /// @param enable true to record events
+        inline void record_input(bool enable = true) noexcept
+        {
+            this->events.set_enabled(enable);
+        }
+
+        /// @brief used to get the window's input event queue. drain it once per frame, or from one other thread, without locking; the message handler is its only producer
+        /// @return reference to the queue
+        inline cgi::input_queue &get_input_queue() noexcept
         {
-            return (cgi::system::cursor::get_y_pos() - this->get_buffer_y_pos());
+            return this->events;
+        }
+
+        /// @brief attaches a frame recorder, every frame passed to buffer_refresh is copied to it while it records. the recorder is not owned and must outlive the window or be detached
+        /// @param frame_recorder recorder to feed, nullptr detaches
+        inline void set_recorder(cgi::frame_recorder *frame_recorder) noexcept
+        {
+            this->recorder = frame_recorder;
+        }
+
+        /// @brief checks if a mouse button is held
+        inline bool is_mouse_down(cgi::type::mouse_button_t button) const noexcept
+        {
+            return this->mouse.is_down(button);
+        }
+
+        /// @brief checks if a mouse button went down since the last frame
+        inline bool is_mouse_pressed(cgi::type::mouse_button_t button) const noexcept
+        {
+            return this->mouse.was_pressed(button);
+        }
+
+        /// @brief checks if a mouse button went up since the last frame
+        inline bool is_mouse_released(cgi::type::mouse_button_t button) const noexcept
+        {
+            return this->mouse.was_released(button);
         }
 
         /// @brief used when trying to pass a custom start function for window
@@ -836,16 +920,43 @@ namespace cgi
             start_function();
         }
 
-        /// @brief refreshes or repaints the client area of buffer area of the window
+        /// @brief refreshes or repaints the parts of the client area that changed since the last refresh
         inline void buffer_refresh() noexcept
         {
-            InvalidateRect(this->details.hwnd, nullptr, TRUE);
+            // recorded before the damage check so an unchanged frame still takes its place in the recording
+            if (this->recorder && this->recorder->is_recording())
+                this->recorder->submit(this->pixels, this->geometry.width, this->geometry.height, this->geometry.stride, this->format);
+
+            if (this->damage.empty())
+                return;
+
+            if (this->presenter.running())
+            {
+                this->presenter.submit(this->pixels, this->geometry.width, this->geometry.height, this->geometry.stride, this->damage);
+                this->damage.reset();
+                return;
+            }
+
+            if (this->damage.is_whole())
+            {
+                InvalidateRect(this->details.hwnd, nullptr, TRUE);
+            }
+            else
+            {
+                for (int i = 0; i < this->damage.size(); i++)
+                {
+                    const cgi::type::rect_t r = this->damage.at(i);
+                    RECT area = {r.x, r.y, r.x + r.width, r.y + r.height};
+                    InvalidateRect(this->details.hwnd, &area, TRUE);
+                }
+            }
+
             UpdateWindow(this->details.hwnd);
         }
 
         /// @brief used to pass a custom execution lopp for windows as how to run it each frame
         /// @param update_function pointer the function of execution loop
-        /// @param refresh_rate refresh rate (default =30fps)
+        /// @param refresh_rate refresh rate, 0 or less runs uncapped (default =30fps)
         void run_as(void (*update_function)(), double refresh_rate = 30)
         {
 
@@ -855,14 +966,28 @@ namespace cgi
                 return;
             }
 
-            this->details.threshold_frame_period = (double)1e9 / refresh_rate;
+            this->details.threshold_frame_period = refresh_rate > 0 ? (double)1e9 / refresh_rate : 0;
+            this->pacer.set_rate(refresh_rate);
 
             this->details.last_frame_time = std::chrono::steady_clock::now();
 
+            // the first frame always runs so an ON_EVENT window has something to show
+            this->redraw.store(true, std::memory_order_relaxed);
+
             while (this->is_open())
             {
+                const bool on_event = this->refresh_type == cgi::type::refresh_t::ON_EVENT;
 
-                auto now_time = std::chrono::steady_clock::now();
+                // idle time is not part of any frame, so it is spent before the frame clock starts
+                if (on_event && !this->redraw.load(std::memory_order_acquire))
+                {
+                    WaitMessage();
+
+                    // the schedule restarts at the wake up, otherwise the idle gap counts as a missed deadline and a long frame period
+                    this->pacer.reset();
+                }
+
+                const auto frame_start = std::chrono::steady_clock::now();
 
                 MSG msg = {};
                 while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
@@ -876,24 +1001,28 @@ namespace cgi
                     }
                 }
 
+                // woken by something that does not change the frame (a move, a repaint), keep sleeping
+                if (on_event && !this->redraw.exchange(false, std::memory_order_acq_rel))
+                    continue;
+
+                auto lap = this->stats.lap(cgi::type::phase_t::PUMP, frame_start);
+
                 update_function();
 
+                this->stats.lap(cgi::type::phase_t::UPDATE, lap);
+
                 // InvalidateRect(this->details.hwnd, nullptr, TRUE);
                 // UpdateWindow(this->details.hwnd);
 
+                // load_view and the blit are timed inside WM_PAINT
                 this->buffer_refresh();
 
-                auto target_end_time = now_time + std::chrono::nanoseconds((int64_t)this->details.threshold_frame_period);
-
-                auto before_sleep = std::chrono::steady_clock::now();
-
-                if (before_sleep < target_end_time)
-                {
-                    std::this_thread::sleep_until(target_end_time);
-                }
+                lap = std::chrono::steady_clock::now();
+                this->pacer.wait();
 
-                auto end = std::chrono::steady_clock::now();
-                this->details.frame_period = std::chrono::duration_cast<std::chrono::nanoseconds>(end - now_time).count();
+                auto end = this->stats.lap(cgi::type::phase_t::WAIT, lap);
+                this->stats.record(cgi::type::phase_t::FRAME, std::chrono::duration_cast<std::chrono::nanoseconds>(end - frame_start).count());
+                this->details.frame_period = this->pacer.frame_period() * 1e9;
 
                 this->val_reset();
                 this->details.last_frame_time = end;
@@ -908,6 +1037,48 @@ namespace cgi
             return (double)this->details.frame_period / 1e9;
         }
 
+        /// @brief used to get the pacer that times run_as. change its mode (UNCAPPED, SLEEP, HYBRID) or read its deadline miss and jitter statistics
+        /// @return reference to the window's frame pacer
+        inline cgi::frame_pacer &get_frame_pacer() noexcept
+        {
+            return this->pacer;
+        }
+
+        /// @brief used to get the per phase timings of run_as and WM_PAINT (pump, update, load_view, blit, wait, frame) with min/mean/p50/p95/p99/max over the last frames
+        /// @return reference to the window's frame statistics
+        inline cgi::frame_stats &get_frame_stats() noexcept
+        {
+            return this->stats;
+        }
+
+        /// @brief used to get the keyboard state built from this window's key messages. pressed/released edges cover the messages handled since the last frame
+        /// @return constant reference to the window's keyboard state
+        inline const cgi::keyboard_state &get_keyboard() const noexcept
+        {
+            return this->keys;
+        }
+
+        /// @brief checks if a key is held, a bit test on the message driven state instead of a GetAsyncKeyState call
+        /// @param key virtual key code, e.g. VK_SPACE or 'A'
+        inline bool is_key_down(int key) const noexcept
+        {
+            return this->keys.is_down(key);
+        }
+
+        /// @brief checks if a key went down since the last frame, taps shorter than a frame are not lost
+        /// @param key virtual key code
+        inline bool is_key_pressed(int key) const noexcept
+        {
+            return this->keys.was_pressed(key);
+        }
+
+        /// @brief checks if a key went up since the last frame
+        /// @param key virtual key code
+        inline bool is_key_released(int key) const noexcept
+        {
+            return this->keys.was_released(key);
+        }
+
         /// @brief used to get the fps of the window
         /// @return return the fps of the window each second
         inline double fps() noexcept
@@ -936,12 +1107,17 @@ namespace cgi
         /// @return LRESULT of windows
         inline LRESULT handle_message(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp)
         {
+            if (is_wake_message(msg))
+                this->redraw.store(true, std::memory_order_release);
+
             switch (msg)
             {
 
             case WM_CREATE:
             {
-                make_bmi(this->get_buffer_width(), this->get_buffer_height());
+                RECT rect_drawable = {};
+                GetClientRect(hwnd, &rect_drawable);
+                build_view(rect_drawable.right - rect_drawable.left, rect_drawable.bottom - rect_drawable.top);
                 break;
             }
 
@@ -950,9 +1126,21 @@ namespace cgi
                 this->details.ps = {};
                 HDC hdc = BeginPaint(hwnd, &this->details.ps);
 
+                // pipelined windows are uploaded by the present thread, the dib already holds the last presented frame
+                if (this->presenter.running())
+                {
+                    std::lock_guard<std::mutex> guard(this->view_lock);
+                    display_view(hdc, this->details.ps.rcPaint);
+                    EndPaint(hwnd, &this->details.ps);
+                    break;
+                }
+
+                auto lap = std::chrono::steady_clock::now();
                 load_view();
+                lap = this->stats.lap(cgi::type::phase_t::LOAD_VIEW, lap);
                 // std::cout<<"here";
-                display_view(hdc);
+                display_view(hdc, this->details.ps.rcPaint);
+                this->stats.lap(cgi::type::phase_t::BLIT, lap);
                 EndPaint(hwnd, &this->details.ps);
 
                 break;
@@ -982,40 +1170,199 @@ namespace cgi
 
             case WM_SIZE:
             {
+                // a minimized window keeps its view, restoring it comes back to the same size
+                if (wp == SIZE_MINIMIZED)
+                    break;
+
+                // the new client size comes with the message, so the geometry snapshot is refreshed here and nowhere else
+                this->pending_width = LOWORD(lp);
+                this->pending_height = HIWORD(lp);
 
-                if (!this->first_log)
+                if (this->pending_width == this->details.width && this->pending_height == this->details.height && this->details.pixel)
                 {
-                    this->resized = true;
+                    this->view_pending = false;
+                    break;
                 }
 
-                cleanup();
+                // while the frame is dragged only rebuild once per throttle, WM_EXITSIZEMOVE applies the final size
+                if (this->sizing)
+                {
+                    const double since = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->last_view_build).count();
+                    if (this->resize_throttle < 0 || since < this->resize_throttle)
+                    {
+                        this->view_pending = true;
+                        break;
+                    }
+                }
 
-                // RECT rect = {};
-                // GetClientRect(hwnd, &rect);
-                // this->details.height = rect.bottom - rect.top;
-                // this->details.width = rect.right - rect.left;
+                resize_view(this->pending_width, this->pending_height);
 
-                this->details.height = this->get_buffer_height();
-                this->details.width = this->get_buffer_width();
+                break;
+            }
 
-                this->details.buffer.clear();
-                this->details.buffer.resize(this->get_buffer_height() * this->get_buffer_width(), this->details.color);
+            case WM_ENTERSIZEMOVE:
+            {
+                this->sizing = true;
+                break;
+            }
 
-                make_bmi(this->details.width, this->details.height);
+            case WM_EXITSIZEMOVE:
+            {
+                this->sizing = false;
 
+                if (this->view_pending)
+                {
+                    resize_view(this->pending_width, this->pending_height);
+                    InvalidateRect(hwnd, nullptr, FALSE);
+                }
                 break;
             }
 
             case WM_MOUSEWHEEL:
             {
-                this->details.scroll_y = (float)GET_WHEEL_DELTA_WPARAM(wp);
+                // several wheel messages can arrive in one frame, they add up until val_reset
+                this->details.scroll_y += (float)GET_WHEEL_DELTA_WPARAM(wp);
+                this->mouse.wheel(0, GET_WHEEL_DELTA_WPARAM(wp));
+
+                cgi::type::input_event_t e;
+                e.kind = cgi::type::input_kind_t::WHEEL;
+                e.delta_y = GET_WHEEL_DELTA_WPARAM(wp);
+                this->events.record(e);
 
                 break;
             }
 
             case WM_MOUSEHWHEEL:
             {
-                this->details.scroll_x = (float)GET_WHEEL_DELTA_WPARAM(wp);
+                this->details.scroll_x += (float)GET_WHEEL_DELTA_WPARAM(wp);
+                this->mouse.wheel(GET_WHEEL_DELTA_WPARAM(wp), 0);
+
+                cgi::type::input_event_t e;
+                e.kind = cgi::type::input_kind_t::WHEEL;
+                e.delta_x = GET_WHEEL_DELTA_WPARAM(wp);
+                this->events.record(e);
+                break;
+            }
+
+            case WM_MOUSEMOVE:
+            {
+                // ask for a WM_MOUSELEAVE every time the cursor comes back in
+                if (!this->mouse.is_inside())
+                {
+                    TRACKMOUSEEVENT track = {};
+                    track.cbSize = sizeof(track);
+                    track.dwFlags = TME_LEAVE;
+                    track.hwndTrack = hwnd;
+                    TrackMouseEvent(&track);
+                }
+
+                // client coordinates are signed, they go negative while a captured drag is left or above the window
+                this->mouse.move((int)(short)LOWORD(lp), (int)(short)HIWORD(lp));
+
+                cgi::type::input_event_t e;
+                e.kind = cgi::type::input_kind_t::MOUSE_MOVE;
+                e.x = this->mouse.get_x();
+                e.y = this->mouse.get_y();
+                this->events.record(e);
+                break;
+            }
+
+            case WM_MOUSELEAVE:
+            {
+                this->mouse.leave();
+                break;
+            }
+
+            case WM_LBUTTONDOWN:
+            case WM_LBUTTONUP:
+            {
+                mouse_button(hwnd, cgi::type::mouse_button_t::LEFT, msg == WM_LBUTTONDOWN, lp);
+                break;
+            }
+
+            case WM_RBUTTONDOWN:
+            case WM_RBUTTONUP:
+            {
+                mouse_button(hwnd, cgi::type::mouse_button_t::RIGHT, msg == WM_RBUTTONDOWN, lp);
+                break;
+            }
+
+            case WM_MBUTTONDOWN:
+            case WM_MBUTTONUP:
+            {
+                mouse_button(hwnd, cgi::type::mouse_button_t::MIDDLE, msg == WM_MBUTTONDOWN, lp);
+                break;
+            }
+
+            case WM_XBUTTONDOWN:
+            case WM_XBUTTONUP:
+            {
+                const cgi::type::mouse_button_t button = GET_XBUTTON_WPARAM(wp) == XBUTTON1 ? cgi::type::mouse_button_t::X1 : cgi::type::mouse_button_t::X2;
+                mouse_button(hwnd, button, msg == WM_XBUTTONDOWN, lp);
+                return TRUE;
+            }
+
+            case WM_CAPTURECHANGED:
+            {
+                // another window took the capture while buttons were held, their up messages will not come here.
+                // lp is null when mouse_button released the capture itself after the last button went up
+                if (lp && (HWND)lp != hwnd && this->mouse.any_down())
+                    this->mouse.release_all();
+                break;
+            }
+
+            case WM_KEYDOWN:
+            case WM_SYSKEYDOWN:
+            {
+                // bit 30 of lparam is set when the key was already down, i.e. auto repeat
+                this->keys.key_down((int)wp, (lp & (1 << 30)) != 0);
+
+                cgi::type::input_event_t e;
+                e.kind = cgi::type::input_kind_t::KEY_DOWN;
+                e.code = (int)wp;
+                e.repeat = (lp & (1 << 30)) != 0;
+                this->events.record(e);
+
+                if (msg == WM_SYSKEYDOWN)
+                    return DefWindowProc(hwnd, msg, wp, lp);
+                break;
+            }
+
+            case WM_KEYUP:
+            case WM_SYSKEYUP:
+            {
+                this->keys.key_up((int)wp);
+
+                cgi::type::input_event_t e;
+                e.kind = cgi::type::input_kind_t::KEY_UP;
+                e.code = (int)wp;
+                this->events.record(e);
+
+                if (msg == WM_SYSKEYUP)
+                    return DefWindowProc(hwnd, msg, wp, lp);
+                break;
+            }
+
+            case WM_CHAR:
+            {
+                this->keys.key_char((unsigned int)wp);
+
+                cgi::type::input_event_t e;
+                e.kind = cgi::type::input_kind_t::CHAR;
+                e.code = (int)wp;
+                this->events.record(e);
+                break;
+            }
+
+            case WM_KILLFOCUS:
+            {
+                // key up messages now go to the focused window, nothing would ever release these
+                this->keys.release_all();
+                this->mouse.release_all();
+
+                cgi::type::input_event_t e;
+                e.kind = cgi::type::input_kind_t::FOCUS_LOST;
+                this->events.record(e);
                 break;
             }
 
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+# =============================================================
+#  CGI - C++ Graphics Ingine
+#  Simple. Effective. Elegant.
+#  Copyright (c) 2025 Siddharth Karn
+#  Licensed under the Apache License, Version 2.0
+#  See LICENSE file in the project root for full license information.
+# =============================================================
+
+# writes cgi_std_font_data.hpp from font.txt
+#   python gen_font_data.py           regenerate the header
+#   python gen_font_data.py --check   fail if the header does not match font.txt
+
+import os
+import sys
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+FONT = os.path.join(ROOT, "font.txt")
+HEADER = os.path.join(ROOT, "cgi_std_font_data.hpp")
+MAX_ROWS = 8
+
+PROLOGUE = """// =============================================================
+//  CGI - C++ Graphics Ingine
+//  Simple. Effective. Elegant.
+//  Copyright (c) 2025 Siddharth Karn
+//  Licensed under the Apache License, Version 2.0
+//  See LICENSE file in the project root for full license information.
+// =============================================================
+
+
+
+#ifndef CGI_STD_FONT_DATA_HPP
+#define CGI_STD_FONT_DATA_HPP
+
+#pragma once
+
+#include <cstdint>
+
+namespace cgi
+{
+    namespace font_data
+    {
+        /// @brief rows a glyph of an embedded font can have
+        constexpr int max_rows = %d;
+
+        /// @brief one glyph of an embedded font. each row reads like the font file, the most significant of the width bits is the leftmost column
+        struct glyph
+        {
+            unsigned char code;
+            unsigned char width;
+            unsigned char height;
+            std::uint8_t rows[max_rows];
+        };
+
+        /// @brief font.txt compiled in, so the default font needs no file and no parsing. generated by gen_font_data.py, edit font.txt and rerun it instead of editing this table
+        constexpr cgi::font_data::glyph standard[] = {
+"""
+
+EPILOGUE = """        };
+
+        /// @brief number of glyphs in the standard table
+        constexpr int standard_count = (int)(sizeof(cgi::font_data::standard) / sizeof(cgi::font_data::standard[0]));
+    }
+}
+
+#endif
+"""
+
+
+def parse(path):
+    glyphs = []
+    current = None
+
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+
+            if line.startswith("~CHAR:"):
+                current = {"code": int(line[6:].split()[0]), "rows": []}
+                glyphs.append(current)
+            elif line and current is not None:
+                if set(line) - {"0", "1"}:
+                    sys.exit("%s:%d: glyph rows may only hold 0 and 1" % (path, number))
+                current["rows"].append(line)
+
+    for g in glyphs:
+        rows = g["rows"]
+        if not rows or len(rows) > MAX_ROWS or len({len(r) for r in rows}) != 1 or len(rows[0]) > 8:
+            sys.exit("%s: glyph %d needs 1 to %d rows of the same width, at most 8 columns" % (path, g["code"], MAX_ROWS))
+
+    return glyphs
+
+
+def literal(code):
+    ch = chr(code)
+    if ch in "'\\":
+        return "'\\%s'" % ch
+    if 32 <= code < 127:
+        return "'%s'" % ch
+    return str(code)
+
+
+def render(glyphs):
+    out = [PROLOGUE % MAX_ROWS]
+    for g in glyphs:
+        rows = g["rows"]
+        bits = ", ".join("0b" + r for r in rows)
+        out.append("            {%s, %d, %d, {%s}},\n" % (literal(g["code"]), len(rows[0]), len(rows), bits))
+    out.append(EPILOGUE)
+    return "".join(out)
+
+
+def main():
+    text = render(parse(FONT))
+
+    if "--check" in sys.argv[1:]:
+        with open(HEADER, newline="") as f:
+            if f.read() != text:
+                sys.exit("cgi_std_font_data.hpp is out of date with font.txt, run gen_font_data.py")
+        return
+
+    with open(HEADER, "w", newline="\n") as f:
+        f.write(text)
+
+
+if __name__ == "__main__":
+    main()
@@ -2,11 +2,11 @@
 
 cgi::window window("mywindowhello", 50, 50, 400, 400, cgi::color::rgb(90, 89, 78));
 
-cgi::type::map2_t rectangle;
+cgi::type::mask_t rectangle;
 void start()
 {
 
-    rectangle.resize(400, cgi::type::map_t(600, '1'));
+    rectangle = cgi::type::mask_t::from_map2_t(cgi::type::map2_t(400, cgi::type::map_t(600, '1')));
 
     window.create();
     window.show();
@@ -16,12 +16,12 @@ void update()
 {
     window.clear();
     std::cout << window.fps() << '\n';
-    window.draw_map2_t(window.get_cursor_x(), window.get_cursor_y(), rectangle, cgi::color::rgb(255, 0, 0));
+    window.draw_mask(window.get_cursor_x(), window.get_cursor_y(), rectangle, cgi::color::rgb(255, 0, 0));
 }
 
 int main()
 {
 
     window.start_as(start);
-    window.run_as(update, 10000000000000000);
+    window.run_as(update, 0);
 }
\ No newline at end of file